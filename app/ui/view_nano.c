@@ -34,6 +34,7 @@
 #include "view_nano.h"
 #include "view_templates.h"
 #include "zxerror.h"
+#include "zxfmt.h"
 #include "zxmacros.h"
 
 extern unsigned int review_type;
@@ -69,14 +70,14 @@ void h_initialize() {
 }
 
 void view_error_show() {
-    snprintf(viewdata.key, MAX_CHARS_PER_KEY_LINE, "ERROR");
-    snprintf(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, "SHOWING DATA");
+    zx_fmt_copy(viewdata.key, MAX_CHARS_PER_KEY_LINE, "ERROR");
+    zx_fmt_copy(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, "SHOWING DATA");
     view_error_show_impl();
 }
 
 void view_custom_error_show(const char *upper, const char *lower) {
-    snprintf(viewdata.key, MAX_CHARS_PER_KEY_LINE, "%s", upper);
-    snprintf(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, "%s", lower);
+    zx_fmt_copy(viewdata.key, MAX_CHARS_PER_KEY_LINE, upper);
+    zx_fmt_copy(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, lower);
     view_custom_error_show_impl();
 }
 
@@ -177,18 +178,22 @@ zxerr_t h_review_update_data() {
     viewdata.pageCount = 1;
 
     if (is_accept_item()) {
-        snprintf(viewdata.key, MAX_CHARS_PER_KEY_LINE, "%s", "");
+        zx_fmt_copy(viewdata.key, MAX_CHARS_PER_KEY_LINE, "");
         if (review_type == REVIEW_MSG) {
-            snprintf(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, APPROVE_LABEL);
+            zx_fmt_copy(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, APPROVE_LABEL);
         } else {
 #if defined(APP_BLINDSIGN_MODE_ENABLED)
             if (app_mode_blindsign_required() && (review_type == REVIEW_TXN || review_type == REVIEW_GROUP_TXN)) {
-                snprintf(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, "%s  %s", APPROVE_LABEL_1, APPROVE_LABEL_2);
+                zx_fmt_t f;
+                zx_fmt_init(&f, viewdata.value, MAX_CHARS_PER_VALUE1_LINE);
+                zx_fmt_str(&f, APPROVE_LABEL_1);
+                zx_fmt_str(&f, "  ");
+                zx_fmt_str(&f, APPROVE_LABEL_2);
             } else {
-                snprintf(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, "%s", APPROVE_LABEL);
+                zx_fmt_copy(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, APPROVE_LABEL);
             }
 #else
-            snprintf(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, "%s", APPROVE_LABEL);
+            zx_fmt_copy(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, APPROVE_LABEL);
 #endif
         }
         splitValueField();
@@ -198,8 +203,8 @@ zxerr_t h_review_update_data() {
     }
 
     if (is_reject_item()) {
-        snprintf(viewdata.key, MAX_CHARS_PER_KEY_LINE, "%s", "");
-        snprintf(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, "%s", REJECT_LABEL);
+        zx_fmt_copy(viewdata.key, MAX_CHARS_PER_KEY_LINE, "");
+        zx_fmt_copy(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, REJECT_LABEL);
         splitValueField();
         zemu_log_stack("show_reject_action - reject item");
         viewdata.pageIdx = 0;
@@ -274,8 +279,8 @@ zxerr_t h_review_update_data() {
 #endif
 #endif
 
-        snprintf(viewdata.key, MAX_CHARS_PER_KEY_LINE, "%s", intro_key);
-        snprintf(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, "%s", intro_value);
+        zx_fmt_copy(viewdata.key, MAX_CHARS_PER_KEY_LINE, intro_key);
+        zx_fmt_copy(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, intro_value);
         splitValueField();
         viewdata.pageIdx = 0;
         return zxerr_ok;
@@ -312,8 +317,13 @@ zxerr_t h_review_update_data() {
         if (viewdata.pageCount > 1) {
             uint8_t keyLen = strnlen(viewdata.key, MAX_CHARS_PER_KEY_LINE);
             if (keyLen < MAX_CHARS_PER_KEY_LINE) {
-                snprintf(viewdata.key + keyLen, MAX_CHARS_PER_KEY_LINE - keyLen, " [%d/%d]", viewdata.pageIdx + 1,
-                         viewdata.pageCount);
+                zx_fmt_t f;
+                zx_fmt_init(&f, viewdata.key + keyLen, MAX_CHARS_PER_KEY_LINE - keyLen);
+                zx_fmt_str(&f, " [");
+                zx_fmt_u64(&f, viewdata.pageIdx + 1, 0);
+                zx_fmt_char(&f, '/');
+                zx_fmt_u64(&f, viewdata.pageCount, 0);
+                zx_fmt_char(&f, ']');
             }
         }
 
@@ -24,6 +24,7 @@
 #include "nbgl_use_case.h"
 #include "ux.h"
 #include "view_internal.h"
+#include "zxfmt.h"
 
 #ifdef APP_SECRET_MODE_ENABLED
 zxerr_t secret_enabled();
@@ -185,8 +186,8 @@ void view_error_show() {
     viewdata.value = viewdata.values[0];
     MEMZERO(viewdata.key, MAX_CHARS_PER_KEY_LINE);
     MEMZERO(viewdata.value, MAX_CHARS_PER_VALUE1_LINE);
-    snprintf(viewdata.key, MAX_CHARS_PER_KEY_LINE, "ERROR");
-    snprintf(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, "SHOWING DATA");
+    zx_fmt_copy(viewdata.key, MAX_CHARS_PER_KEY_LINE, "ERROR");
+    zx_fmt_copy(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, "SHOWING DATA");
     view_error_show_impl();
 }
 
@@ -195,8 +196,8 @@ void view_custom_error_show(const char *upper, const char *lower) {
     viewdata.value = viewdata.values[0];
     MEMZERO(viewdata.key, MAX_CHARS_PER_KEY_LINE);
     MEMZERO(viewdata.value, MAX_CHARS_PER_VALUE1_LINE);
-    snprintf(viewdata.key, MAX_CHARS_PER_KEY_LINE, "%s", upper);
-    snprintf(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, "%s", lower);
+    zx_fmt_copy(viewdata.key, MAX_CHARS_PER_KEY_LINE, upper);
+    zx_fmt_copy(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, lower);
     nbgl_useCaseChoice(&C_IMPORTANT_CIRCLE_ICON, viewdata.key, viewdata.value, "Ok", "", confirm_error);
 }
 
@@ -298,8 +299,13 @@ zxerr_t h_review_update_data() {
                                                  MAX_CHARS_PER_VALUE1_LINE, innerIdx, &viewdata.pageCount))
             if (viewdata.pageCount > 1) {
                 const uint8_t titleLen = strnlen(viewdata.key, MAX_CHARS_PER_KEY_LINE);
-                snprintf(viewdata.key + titleLen, MAX_CHARS_PER_KEY_LINE - titleLen, " (%d/%d)", innerIdx + 1,
-                         viewdata.pageCount);
+                zx_fmt_t f;
+                zx_fmt_init(&f, viewdata.key + titleLen, MAX_CHARS_PER_KEY_LINE - titleLen);
+                zx_fmt_str(&f, " (");
+                zx_fmt_u64(&f, innerIdx + 1, 0);
+                zx_fmt_char(&f, '/');
+                zx_fmt_u64(&f, viewdata.pageCount, 0);
+                zx_fmt_char(&f, ')');
             }
             return zxerr_ok;
         }
@@ -411,12 +417,12 @@ void view_idle_show_impl(__Z_UNUSED uint8_t item_idx, const char *statusString)
     if (statusString == NULL) {
 #ifdef APP_SECRET_MODE_ENABLED
         if (app_mode_secret()) {
-            snprintf(viewdata.key, MAX_CHARS_PER_KEY_LINE, "%s", MENU_MAIN_APP_LINE2_SECRET);
+            zx_fmt_copy(viewdata.key, MAX_CHARS_PER_KEY_LINE, MENU_MAIN_APP_LINE2_SECRET);
             home_text = viewdata.key;
         }
 #endif
     } else {
-        snprintf(viewdata.key, MAX_CHARS_PER_KEY_LINE, "%s", statusString);
+        zx_fmt_copy(viewdata.key, MAX_CHARS_PER_KEY_LINE, statusString);
     }
 
     settingContents.callbackCallNeeded = true;
@@ -433,15 +439,15 @@ void view_idle_show_impl(__Z_UNUSED uint8_t item_idx, const char *statusString)
 
 void view_message_impl(const char *title, const char *message) {
     viewdata.value = viewdata.values[0];
-    uint32_t titleLen = 0;
-    if (title != NULL) {
-        snprintf(viewdata.value, MAX_CHARS_PER_VALUE1_LINE, "%s", title);
-        titleLen = strnlen(title, MAX_CHARS_PER_VALUE1_LINE);
-    }
+    zx_fmt_t f;
+    zx_fmt_init(&f, viewdata.value, MAX_CHARS_PER_VALUE1_LINE);
+    zx_fmt_str(&f, title);
 
     if (message != NULL) {
-        const char sep = (titleLen > 0) ? 0x0A : 0x00;
-        snprintf(viewdata.value, MAX_CHARS_PER_VALUE1_LINE - titleLen, "%c%s", sep, message);
+        if (f.len > 0) {
+            zx_fmt_char(&f, 0x0A);
+        }
+        zx_fmt_str(&f, message);
     }
 
     nbgl_useCaseSpinner(viewdata.value);
@@ -641,16 +647,14 @@ void view_review_show_with_intent_impl(unsigned int requireReply, const char *in
     if (intent != NULL && strlen(intent) > 0) {
         // Show everything on a single line for NBGL
         const char *review_text = (review_type == REVIEW_MSG) ? "Review message" : "Review transaction";
-        int ret = snprintf(intro_msg_buf, sizeof(intro_msg_buf), "%s to %s", review_text, intent);
+        zx_fmt_t f;
+        zx_fmt_init(&f, intro_msg_buf, sizeof(intro_msg_buf));
+        zx_fmt_str(&f, review_text);
+        zx_fmt_str(&f, " to ");
+        zx_fmt_str(&f, intent);
 
-        // Check for snprintf error
-        if (ret < 0) {
-            // Handle encoding error - use a default message
-            strncpy(intro_msg_buf, review_text, sizeof(intro_msg_buf) - 1);
-            intro_msg_buf[sizeof(intro_msg_buf) - 1] = '\0';
-        }
         // Check if truncation occurred and add ellipsis if needed
-        else if ((size_t)ret >= sizeof(intro_msg_buf)) {
+        if (zx_fmt_status(&f) != zxerr_ok) {
             const size_t buf_len = sizeof(intro_msg_buf);
             if (buf_len >= 4) {
                 intro_msg_buf[buf_len - 4] = '.';
@@ -664,16 +668,14 @@ void view_review_show_with_intent_impl(unsigned int requireReply, const char *in
 
         // Format the approval label with intent for the final approval screen
         const char *sign_text = (review_type == REVIEW_MSG) ? "Sign message" : "Sign transaction";
-        ret = snprintf(approval_label_buf, sizeof(approval_label_buf), "%s to %s?", sign_text, intent);
+        zx_fmt_init(&f, approval_label_buf, sizeof(approval_label_buf));
+        zx_fmt_str(&f, sign_text);
+        zx_fmt_str(&f, " to ");
+        zx_fmt_str(&f, intent);
+        zx_fmt_char(&f, '?');
 
-        // Check for snprintf error
-        if (ret < 0) {
-            // Handle encoding error - use a default message
-            strncpy(approval_label_buf, sign_text, sizeof(approval_label_buf) - 1);
-            approval_label_buf[sizeof(approval_label_buf) - 1] = '\0';
-        }
         // Check if truncation occurred and add ellipsis if needed
-        else if ((size_t)ret >= sizeof(approval_label_buf)) {
+        if (zx_fmt_status(&f) != zxerr_ok) {
             const size_t buf_len = sizeof(approval_label_buf);
             if (buf_len >= 4) {
                 approval_label_buf[buf_len - 4] = '.';
@@ -684,8 +686,8 @@ void view_review_show_with_intent_impl(unsigned int requireReply, const char *in
         }
     } else {
         // Use default labels if no intent
-        snprintf(approval_label_buf, sizeof(approval_label_buf), "%s",
-                 (review_type == REVIEW_MSG) ? APPROVE_LABEL_NBGL_MSG : APPROVE_LABEL_NBGL);
+        zx_fmt_copy(approval_label_buf, sizeof(approval_label_buf),
+                    (review_type == REVIEW_MSG) ? APPROVE_LABEL_NBGL_MSG : APPROVE_LABEL_NBGL);
     }
 
     h_paging_init();
@@ -55,8 +55,11 @@ zxerr_t eth_addr_getItem(int8_t displayIdx, char *outKey, uint16_t outKeyLen, ch
             }
 
             snprintf(outKey, outKeyLen, "Path");
-            bip32_to_str(buffer, sizeof(buffer), hdPathEth, hdPathEth_len);
-            pageString(outVal, outValLen, buffer, pageIdx, pageCount);
+            const uint16_t pathStrLen = bip32_to_str_len(buffer, sizeof(buffer), hdPathEth, hdPathEth_len);
+            if (pathStrLen == 0) {
+                return zxerr_buffer_too_small;
+            }
+            pageStringExt(outVal, outValLen, buffer, pathStrLen, pageIdx, pageCount);
             return zxerr_ok;
         }
         default:
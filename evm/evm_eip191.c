@@ -65,17 +65,7 @@ zxerr_t eip191_msg_getItem(int8_t displayIdx, char *outKey, uint16_t outKeyLen,
         }
         case 1: {
             snprintf(outKey, outKeyLen, "Msg hex");
-            uint8_t is_printable = 1;
-
-            // Check if all characters are printable
-            for (uint16_t i = 0; i < messageLength; i++) {
-                if (!IS_PRINTABLE(message[i])) {
-                    is_printable = 0;
-                    break;
-                }
-            }
-
-            if (messageLength > 0 && is_printable == 0) {
+            if (messageLength > 0 && !zx_swar_all_printable(message, messageLength)) {
                 pageStringHex(outVal, outValLen, (const char *)message, messageLength, pageIdx, pageCount);
                 return zxerr_ok;
             }
@@ -96,13 +86,8 @@ bool eip191_msg_parse() {
     const uint8_t *message = tx_get_buffer() + sizeof(uint32_t);
     const uint16_t messageLength = tx_get_buffer_length() - sizeof(uint32_t);
     // Check if all characters are printable
-    for (uint16_t i = 0; i < messageLength; i++) {
-        if (!IS_PRINTABLE(message[i])) {
-            if (!app_mode_blindsign()) {
-                return false;
-            }
-            break;
-        }
+    if (!zx_swar_all_printable(message, messageLength) && !app_mode_blindsign()) {
+        return false;
     }
 
     return true;
@@ -128,8 +113,8 @@ zxerr_t eip191_hash_message(const uint8_t *message, uint16_t messageLen, uint8_t
     }
 
     uint32_t msg_len = U4BE(message, 0);
-    uint32_to_str(len_str, sizeof(len_str), msg_len);
-    if (cx_hash_no_throw((cx_hash_t *)&sha3, 0, (uint8_t *)len_str, strlen(len_str), NULL, 0) != CX_OK) {
+    const uint16_t len_str_len = uint32_to_str_len(len_str, sizeof(len_str), msg_len);
+    if (cx_hash_no_throw((cx_hash_t *)&sha3, 0, (uint8_t *)len_str, len_str_len, NULL, 0) != CX_OK) {
         MEMZERO(&sha3, sizeof(sha3));
         return zxerr_unknown;
     }
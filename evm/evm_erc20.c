@@ -75,17 +75,19 @@ parser_error_t printERC20Value(const eth_tx_t *ethObj, char *outVal, uint16_t ou
         return parser_unexpected_error;
     }
 
-    // Add symbol, add decimals, page number
-    if (intstr_to_fpstr_inplace(bufferUI, sizeof(bufferUI), decimals) == 0) {
+    // Add decimals, trim, add symbol and page number without leaving bufferUI
+    zx_strbuf_t sb;
+    if (zx_strbuf_wrap(&sb, bufferUI, sizeof(bufferUI)) != zxerr_ok || intstr_to_fpstr_sb(&sb, decimals) != zxerr_ok) {
         return parser_unexpected_value;
     }
+    number_trimming_sb(&sb, 1);
 
-    if (z_str3join(bufferUI, sizeof(bufferUI), tokenSymbol, NULL) != zxerr_ok) {
+    if (zx_strbuf_prepend(&sb, tokenSymbol, strnlen(tokenSymbol, sizeof(tokenSymbol))) != zxerr_ok) {
         return parser_unexpected_buffer_end;
     }
 
-    number_inplace_trimming(bufferUI, 1);
-    pageString(outVal, outValLen, bufferUI, pageIdx, pageCount);
+    const uint16_t len = zx_strbuf_finish(&sb);
+    pageStringExt(outVal, outValLen, bufferUI, len, pageIdx, pageCount);
 
     return parser_ok;
 }
@@ -157,12 +157,6 @@ parser_error_t printRLPNumber(const rlp_t *num, char *outVal, uint16_t outValLen
 #define LESS_THAN_64_DIGIT(num_digit) \
     if (num_digit > 64) return parser_value_out_of_range;
 
-__Z_INLINE bool format_quantity(const uint8_t *num, uint16_t num_len, uint8_t *bcd, uint16_t bcdSize, char *bignum,
-                                uint16_t bignumSize) {
-    bignumBigEndian_to_bcd(bcd, bcdSize, num, num_len);
-    return bignumBigEndian_bcdprint(bignum, bignumSize, bcd, bcdSize);
-}
-
 parser_error_t printBigIntFixedPoint(const uint8_t *number, uint16_t number_len, char *outVal, uint16_t outValLen,
                                      uint8_t pageIdx, uint8_t *pageCount, uint16_t decimals) {
     if (number == NULL || outVal == NULL || pageCount == NULL) {
@@ -171,25 +165,13 @@ parser_error_t printBigIntFixedPoint(const uint8_t *number, uint16_t number_len,
 
     LESS_THAN_64_DIGIT(number_len);
 
-    char bignum[160] = {0};
-    union {
-        // overlapping arrays to avoid excessive stack usage. Do not use at the same time
-        uint8_t bcd[80];
-        char output[160];
-    } overlapped;
-
-    MEMZERO(&overlapped, sizeof(overlapped));
-
-    if (!format_quantity(number, number_len, overlapped.bcd, sizeof(overlapped.bcd), bignum, sizeof(bignum))) {
-        return parser_unexpected_value;
-    }
-
-    if (fpstr_to_str(overlapped.output, sizeof(overlapped.output), bignum, decimals)) {
+    char output[160] = {0};
+    const uint16_t outputLen = bignum_to_fpstr(output, sizeof(output), number, number_len, decimals, bool_true);
+    if (outputLen == 0) {
         return parser_unexpected_value;
     }
 
-    number_inplace_trimming(overlapped.output, 1);
-    pageString(outVal, outValLen, overlapped.output, pageIdx, pageCount);
+    pageStringExt(outVal, outValLen, output, outputLen, pageIdx, pageCount);
     return parser_ok;
 }
 
@@ -32,6 +32,21 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
     const int encode_result = encode_base58(data, size, encode_output, &encode_outlen);
     (void)encode_result;
 
+    // Test the caller-scratch variants, which accept any length
+    std::vector<unsigned char> decode_scratch(BASE58_DECODE_SCRATCH_LEN(size));
+    std::vector<unsigned char> decode_ex_output(size);
+    size_t decode_ex_outlen = decode_ex_output.size();
+    const int decode_ex_result = decode_base58_ex(decode_input.data(), size, decode_ex_output.data(),
+                                                  &decode_ex_outlen, decode_scratch.data(), decode_scratch.size());
+    (void)decode_ex_result;
+
+    std::vector<uint32_t> encode_scratch(BASE58_ENCODE_SCRATCH_LIMBS(size));
+    std::vector<unsigned char> encode_ex_output(size * 2);
+    size_t encode_ex_outlen = encode_ex_output.size();
+    const int encode_ex_result = encode_base58_ex(data, size, encode_ex_output.data(), &encode_ex_outlen,
+                                                  encode_scratch.data(), encode_scratch.size());
+    (void)encode_ex_result;
+
     // Test encode_base58_clip
     if (size > 0) {
         const char clip_result = encode_base58_clip(data[0]);
@@ -50,5 +50,12 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
     // The fuzzer is looking for crashes, not correctness
     (void)result;
 
+    // Streaming encoder rendered page by page, without the 90-character limit
+    char page[33];
+    uint8_t pageCount = 0;
+    const uint8_t pageIdx = input_data[0] % 8;
+    (void)bech32EncodeFromBytesPaged(page, sizeof(page), hrp, input_data, input_size, pad, enc, 1023, pageIdx,
+                                     &pageCount);
+
     return 0;
 }
\ No newline at end of file
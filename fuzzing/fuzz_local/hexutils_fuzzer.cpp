@@ -26,6 +26,10 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
     const size_t result = parseHexString(output, output_size, input);
     (void)result;
 
+    // Explicit-length decoder reads the raw input, no terminator
+    const size_t resultExt = parseHexStringExt(output, output_size, reinterpret_cast<const char *>(data), size);
+    (void)resultExt;
+
     delete[] input;
 
     return 0;
@@ -53,6 +53,24 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
     printTimeSpecialFormat(buffer, sizeof(buffer), timestamp);
     printTimeSpecialFormat(buffer, 50, timestamp);
 
+    // Test printTimeRFC3339 with signed seconds, nanos, precision and timezone offset from the input
+    if (size >= 16) {
+        int64_t seconds;
+        uint32_t nanos;
+        int16_t offset;
+        memcpy(&seconds, data, sizeof(seconds));
+        memcpy(&nanos, data + 8, sizeof(nanos));
+        memcpy(&offset, data + 12, sizeof(offset));
+        const uint8_t precision = data[14] % 11;  // 0-10, 10 is invalid
+        const bool_t trim = (data[15] & 1) ? bool_true : bool_false;
+
+        const size_t len = printTimeRFC3339(buffer, sizeof(buffer), seconds, nanos, precision, offset, trim);
+        assert(len <= RFC3339_MAX_LEN);
+        assert(strlen(buffer) == len);
+        printTimeRFC3339(buffer, 21, seconds, nanos, precision, offset, trim);
+        printTimeRFC3339(buffer, 1, seconds, nanos, precision, offset, trim);
+    }
+
     // Test month functions
     if (size > 0) {
         const uint8_t month = data[0] % 13;  // 0-12
@@ -136,6 +136,8 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
         bip32_to_str(bip32Buffer, 5, path, pathLen);
         bip32_to_str(bip32Buffer, sizeof(bip32Buffer), path, 0);
         bip32_to_str(bip32Buffer, sizeof(bip32Buffer), path, 6);
+        bip32_to_str_len(bip32Buffer, sizeof(bip32Buffer), path, 6);
+        bip32_to_str_len(bip32Buffer, 10, path, pathLen);
     }
 
     // Test str_to_int8
@@ -244,6 +246,8 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
         formatBufferData(localBuffer, dataLen, formattedOutput, 10, pageIdx, &pageCount);
         // Test with valid length instead of 501 which exceeds our local buffer
         formatBufferData(localBuffer, copyLen, formattedOutput, outputLen, pageIdx, &pageCount);
+        // No size cap: render straight from the whole input
+        formatBufferData(data, size, formattedOutput, outputLen, data[1], &pageCount);
 
         // Test with non-ASCII data
         uint8_t nonAsciiData[64];
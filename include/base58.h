@@ -25,12 +25,66 @@
 extern "C" {
 #endif
 
+// Encoded length bounds of 32- and 64-byte values (leading zero bytes included)
+#define BASE58_32_MIN_ENCODED_LEN 32
+#define BASE58_32_MAX_ENCODED_LEN 44
+#define BASE58_64_MIN_ENCODED_LEN 64
+#define BASE58_64_MAX_ENCODED_LEN 88
+
+// Scratch needed by the _ex variants for LEN input bytes (encode) or characters (decode).
+// log(256) / log(58^5) ~= 0.2732 limbs per byte, rounded up
+#define BASE58_ENCODE_SCRATCH_LIMBS(LEN) (((LEN) * 2732u) / 10000u + 1u)
+#define BASE58_DECODE_SCRATCH_LEN(LEN) (LEN)
+
 int decode_base58(const char *in, size_t length, unsigned char *out, size_t *outlen);
 
 int encode_base58(const unsigned char *in, size_t length, unsigned char *out, size_t *outlen);
 
+// Same as decode_base58/encode_base58 but without input size limits. The
+// caller provides the working memory, nothing large is kept on the stack.
+// decode_base58_ex builds the result directly inside out.
+int decode_base58_ex(const char *in, size_t length, unsigned char *out, size_t *outlen, unsigned char *scratch,
+                     size_t scratchLen);
+
+int encode_base58_ex(const unsigned char *in, size_t length, unsigned char *out, size_t *outlen, uint32_t *scratch,
+                     size_t scratchLimbs);
+
 char encode_base58_clip(unsigned char v);
 
+#define BASE58_CHECKSUM_MAX_LEN 32
+
+// Checksum callback for Base58Check. Writes the first checksumLen bytes of the
+// hash of prefix || payload (e.g. double SHA256, or blake2b-512 over
+// "SS58PRE" || prefix || payload). Either part may be empty. Returns 0 on success.
+typedef int (*base58_checksum_fn)(const unsigned char *prefix, size_t prefixLen, const unsigned char *payload,
+                                  size_t payloadLen, unsigned char *checksum, size_t checksumLen);
+
+// Encodes version || payload || checksum without building the concatenation.
+// Same *outlen contract as encode_base58.
+int encode_base58check(const unsigned char *version, size_t versionLen, const unsigned char *payload,
+                       size_t payloadLen, size_t checksumLen, base58_checksum_fn checksum, unsigned char *out,
+                       size_t *outlen);
+
+// Decodes a Base58Check string and verifies its trailing checksumLen bytes.
+// On success out holds version || payload (checksum stripped) and *outlen its length.
+int decode_base58check(const char *in, size_t length, size_t checksumLen, base58_checksum_fn checksum,
+                       unsigned char *out, size_t *outlen);
+
+// Fixed-width variants for 32- and 64-byte values. They follow the same *outlen
+// contract as encode_base58/decode_base58 and are used by them automatically.
+// Decoding fails unless the string represents exactly 32 (or 64) bytes.
+int encode_base58_32(const unsigned char *in, unsigned char *out, size_t *outlen);
+int encode_base58_64(const unsigned char *in, unsigned char *out, size_t *outlen);
+int decode_base58_32(const char *in, size_t length, unsigned char *out, size_t *outlen);
+int decode_base58_64(const char *in, size_t length, unsigned char *out, size_t *outlen);
+
+// Block base58 as used by CryptoNote chains (Monero). Each 8-byte block maps
+// to 11 characters independently; the last block may be partial. Same *outlen
+// contract as encode_base58/decode_base58.
+size_t base58_block_encoded_len(size_t length);
+int encode_base58_block(const unsigned char *in, size_t length, unsigned char *out, size_t *outlen);
+int decode_base58_block(const char *in, size_t length, unsigned char *out, size_t *outlen);
+
 #ifdef __cplusplus
 }
 #endif
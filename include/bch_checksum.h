@@ -0,0 +1,110 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+// Table-driven BCH checksum engine for the bech32 family of encodings.
+//
+// A variant is described by its state width in bits and a T5 macro, the XOR of the five generators
+// selected by the bits of a 5-bit value. BCH_CHECKSUM_DEFINE(NAME, TYPE, WIDTH, T5) instantiates, in the
+// including translation unit, constant lookup tables and the functions
+//
+//     TYPE NAME_step1(TYPE state, uint8_t v)
+//     TYPE NAME_step2(TYPE state, uint8_t v1, uint8_t v2)
+//     TYPE NAME_update(TYPE state, const uint8_t *symbols, size_t n)
+//
+// The tables are generated by the preprocessor from the generators, so a new variant only needs its
+// descriptor macros. By default two symbols are absorbed per lookup in a 1024-entry table. Defining
+// BCH_CHECKSUM_COMPACT (the default on TARGET_NANOS) keeps only the 32-entry table and absorbs one
+// symbol per lookup.
+//
+// Zcash unified addresses and Cardano use the bech32/bech32m polymod itself; only their length limits
+// differ, so they share the BCH_BECH32 descriptor.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zxmacros.h"
+
+#if !defined(BCH_CHECKSUM_COMPACT) && defined(TARGET_NANOS)
+#define BCH_CHECKSUM_COMPACT
+#endif
+
+// Variant descriptors
+#define BCH_BECH32_WIDTH 30
+#define BCH_BECH32_T5(b) BCH_T5(0x3b6a57b2u, 0x26508e6du, 0x1ea119fau, 0x3d4233ddu, 0x2a1462b3u, b)
+
+#define BCH_CASHADDR_WIDTH 40
+#define BCH_CASHADDR_T5(b) \
+    BCH_T5(0x98f2bc8e61ull, 0x79b76d99e2ull, 0xf33e5fb3c4ull, 0xae2eabe2a8ull, 0x1e4f43e470ull, b)
+
+#define BCH_T5(G0, G1, G2, G3, G4, b)                                                                            \
+    ((((b) & 1u) ? (G0) : 0u) ^ (((b) & 2u) ? (G1) : 0u) ^ (((b) & 4u) ? (G2) : 0u) ^ (((b) & 8u) ? (G3) : 0u) ^ \
+     (((b) & 16u) ? (G4) : 0u))
+
+#define BCH_MASK(BITS) ((((uint64_t)1u) << (BITS)) - 1u)
+
+// Entry h of the two-symbol table: two zero-symbol steps applied to h << (WIDTH - 10)
+#define BCH_T5_ENTRY(T5, WIDTH, b) T5(b)
+#define BCH_T10_ENTRY(T5, WIDTH, h) \
+    (((T5((h) >> 5u) & BCH_MASK((WIDTH) - 5)) << 5u) ^ T5(((h) & 31u) ^ (T5((h) >> 5u) >> ((WIDTH) - 5))))
+
+#define BCH_REP8(M, T5, W, o)                                                                           \
+    M(T5, W, (o) + 0u), M(T5, W, (o) + 1u), M(T5, W, (o) + 2u), M(T5, W, (o) + 3u), M(T5, W, (o) + 4u), \
+        M(T5, W, (o) + 5u), M(T5, W, (o) + 6u), M(T5, W, (o) + 7u)
+#define BCH_REP32(M, T5, W, o)                                                                 \
+    BCH_REP8(M, T5, W, (o) + 0u), BCH_REP8(M, T5, W, (o) + 8u), BCH_REP8(M, T5, W, (o) + 16u), \
+        BCH_REP8(M, T5, W, (o) + 24u)
+#define BCH_REP256(M, T5, W, o)                                                                           \
+    BCH_REP32(M, T5, W, (o) + 0u), BCH_REP32(M, T5, W, (o) + 32u), BCH_REP32(M, T5, W, (o) + 64u),        \
+        BCH_REP32(M, T5, W, (o) + 96u), BCH_REP32(M, T5, W, (o) + 128u), BCH_REP32(M, T5, W, (o) + 160u), \
+        BCH_REP32(M, T5, W, (o) + 192u), BCH_REP32(M, T5, W, (o) + 224u)
+#define BCH_REP1024(M, T5, W) \
+    BCH_REP256(M, T5, W, 0u), BCH_REP256(M, T5, W, 256u), BCH_REP256(M, T5, W, 512u), BCH_REP256(M, T5, W, 768u)
+
+#define BCH_CHECKSUM_DEFINE_STEP1(NAME, TYPE, WIDTH, T5)                                                      \
+    static const TYPE NAME##_table5[32] = {BCH_REP32(BCH_T5_ENTRY, T5, WIDTH, 0u)};                           \
+    __Z_INLINE TYPE NAME##_step1(TYPE state, uint8_t v) {                                                     \
+        return (TYPE)(((state & (TYPE)BCH_MASK((WIDTH) - 5)) << 5u) ^ NAME##_table5[state >> ((WIDTH) - 5)] ^ \
+                      v);                                                                                     \
+    }
+
+#if defined(BCH_CHECKSUM_COMPACT)
+#define BCH_CHECKSUM_DEFINE_STEP2(NAME, TYPE, WIDTH, T5)               \
+    __Z_INLINE TYPE NAME##_step2(TYPE state, uint8_t v1, uint8_t v2) { \
+        return NAME##_step1(NAME##_step1(state, v1), v2);              \
+    }
+#else
+#define BCH_CHECKSUM_DEFINE_STEP2(NAME, TYPE, WIDTH, T5)                                                          \
+    static const TYPE NAME##_table10[1024] = {BCH_REP1024(BCH_T10_ENTRY, T5, WIDTH)};                             \
+    __Z_INLINE TYPE NAME##_step2(TYPE state, uint8_t v1, uint8_t v2) {                                            \
+        return (TYPE)(((state & (TYPE)BCH_MASK((WIDTH) - 10)) << 10u) ^ NAME##_table10[state >> ((WIDTH) - 10)] ^ \
+                      ((TYPE)v1 << 5u) ^ v2);                                                                     \
+    }
+#endif
+
+#define BCH_CHECKSUM_DEFINE(NAME, TYPE, WIDTH, T5)                                \
+    BCH_CHECKSUM_DEFINE_STEP1(NAME, TYPE, WIDTH, T5)                              \
+    BCH_CHECKSUM_DEFINE_STEP2(NAME, TYPE, WIDTH, T5)                              \
+    __Z_INLINE TYPE NAME##_update(TYPE state, const uint8_t *symbols, size_t n) { \
+        size_t i = 0;                                                             \
+        for (; i + 1 < n; i += 2) {                                               \
+            state = NAME##_step2(state, symbols[i], symbols[i + 1]);              \
+        }                                                                         \
+        if (i < n) {                                                              \
+            state = NAME##_step1(state, symbols[i]);                              \
+        }                                                                         \
+        return state;                                                             \
+    }
@@ -31,6 +31,46 @@ extern "C" {
 zxerr_t bech32EncodeFromBytes(char *out, size_t out_len, const char *hrp, const uint8_t *in, size_t in_len, uint8_t pad,
                               bech32_encoding enc);
 
+// Length limit of BIP173 strings. Long-form users (Zcash unified addresses, Cardano keys)
+// pass their own limit to the streaming encoder.
+#define BECH32_MAX_LEN 90
+
+// Streaming encoder: produces the bech32 string for 8-bit input one chunk at a time, so
+// long strings never need to be materialized. The checksum is updated as the data
+// symbols are produced and emitted after the last one.
+typedef struct {
+    const char *hrp;
+    const uint8_t *in;
+    size_t hrp_len;
+    size_t in_len;
+    size_t in_pos;
+    size_t data_end;  // position right after the last data symbol
+    size_t total_len;
+    size_t pos;
+    uint32_t chk;
+    uint8_t sym[8];
+    uint8_t sym_len;
+    uint8_t sym_pos;
+    uint8_t pad;
+    bech32_encoding enc;
+} bech32_stream_t;
+
+// Validates the parameters and computes the encoded length (ctx->total_len).
+// Fails with zxerr_out_of_bounds if the string would be longer than max_len.
+zxerr_t bech32_stream_init(bech32_stream_t *ctx, const char *hrp, const uint8_t *in, size_t in_len, uint8_t pad,
+                           bech32_encoding enc, size_t max_len);
+
+// Writes the next (at most out_len - 1) characters and a null terminator
+zxerr_t bech32_stream_read(bech32_stream_t *ctx, char *out, size_t out_len, size_t *written);
+
+// Advances over count characters without writing them
+zxerr_t bech32_stream_skip(bech32_stream_t *ctx, size_t count);
+
+// Renders page pageIdx of the encoded string with the same page layout as pageStringExt
+zxerr_t bech32EncodeFromBytesPaged(char *outValue, uint16_t outValueLen, const char *hrp, const uint8_t *in,
+                                   size_t in_len, uint8_t pad, bech32_encoding enc, size_t max_len, uint8_t pageIdx,
+                                   uint8_t *pageCount);
+
 #ifdef __cplusplus
 }
 #endif
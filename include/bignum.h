@@ -23,12 +23,40 @@ extern "C" {
 #include <zxmacros.h>
 #include <zxtypes.h>
 
+// Values longer than this (leading zero bytes excluded) fall back to double-dabble in the *_to_bcd functions
+// and are rejected by the *_to_decimal functions.
+#ifndef BIGNUM_DEC_MAX_INPUT_LEN
+#define BIGNUM_DEC_MAX_INPUT_LEN 64
+#endif
+
+// Decimal digits produced per division step
+#if defined(__SIZEOF_INT128__) && !defined(BIGNUM_DEC_RADIX_1E9)
+#define BIGNUM_DEC_CHUNK_DIGITS 19
+#else
+#define BIGNUM_DEC_CHUNK_DIGITS 9
+#endif
+
 bool_t bignumLittleEndian_bcdprint(char *outBuffer, uint16_t outBufferLen, const uint8_t *inBCD, uint16_t inBCDLen);
 void bignumLittleEndian_to_bcd(uint8_t *bcdOut, uint16_t bcdOutLen, const uint8_t *binValue, uint16_t binValueLen);
 
 bool_t bignumBigEndian_bcdprint(char *outBuffer, uint16_t outBufferLen, const uint8_t *bcdIn, uint16_t bcdInLen);
 void bignumBigEndian_to_bcd(uint8_t *bcdOut, uint16_t bcdOutLen, const uint8_t *binValue, uint16_t binValueLen);
 
+// Write the value as a null-terminated decimal string without leading zeros ("0" for zero).
+// Returns bool_false, with outBuffer zeroed, if it does not fit or the value exceeds BIGNUM_DEC_MAX_INPUT_LEN bytes.
+bool_t bignumLittleEndian_to_decimal(char *outBuffer, uint16_t outBufferLen, const uint8_t *binValue,
+                                     uint16_t binValueLen);
+
+bool_t bignumBigEndian_to_decimal(char *outBuffer, uint16_t outBufferLen, const uint8_t *binValue,
+                                  uint16_t binValueLen);
+
+// Write a big-endian value as a fixed point decimal with `decimals` fractional digits ("1234.5", "0.05").
+// With trim, trailing fractional zeros are dropped but one fractional digit is kept ("1.0").
+// Returns the string length, or 0 with out zeroed if it does not fit or the value exceeds
+// BIGNUM_DEC_MAX_INPUT_LEN bytes.
+uint16_t bignum_to_fpstr(char *out, uint16_t outLen, const uint8_t *bytes, uint16_t len, uint16_t decimals,
+                         bool_t trim);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,43 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zxerror.h"
+
+#define CASHADDR_CHECKSUM_SYMBOLS 8
+#define CASHADDR_CONST 1
+
+// Feeds 5-bit symbols into the 40-bit CashAddr polymod. The initial state is 1.
+uint64_t cashaddr_checksum_update(uint64_t state, const uint8_t *symbols, size_t n);
+
+// Computes the CASHADDR_CHECKSUM_SYMBOLS checksum symbols for a prefix (without ':')
+// and a 5-bit payload
+zxerr_t cashaddr_create_checksum(uint8_t *checksum, size_t checksumLen, const char *prefix, const uint8_t *data,
+                                 size_t dataLen);
+
+// Checks a 5-bit payload whose last CASHADDR_CHECKSUM_SYMBOLS symbols are the checksum
+zxerr_t cashaddr_verify_checksum(const char *prefix, const uint8_t *data, size_t dataLen);
+
+#ifdef __cplusplus
+}
+#endif
@@ -25,6 +25,11 @@ extern "C" {
 
 size_t parseHexString(uint8_t *out, uint16_t outLen, const char *input);
 
+// Decodes inputLen hex characters (either case) into out, eight characters at a time.
+// Returns the number of bytes written, or 0 if inputLen is odd, out is too small or a
+// character is not a hex digit.
+size_t parseHexStringExt(uint8_t *out, size_t outLen, const char *input, size_t inputLen);
+
 #ifdef __cplusplus
 }
 #endif
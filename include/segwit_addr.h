@@ -25,6 +25,10 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /** Encode a SegWit address
  *
  *  Out: output:   Pointer to a buffer of size 73 + strlen(hrp) that will be
@@ -43,7 +47,9 @@ int segwit_addr_encode(char *output, const char *hrp, int ver, const uint8_t *pr
  *  Out: ver:      Pointer to an int that will be updated to contain the witness
  *                 program version (between 0 and 16 inclusive).
  *       prog:     Pointer to a buffer of size 40 that will be updated to
- *                 contain the witness program bytes.
+ *                 contain the witness program bytes. The program is written
+ *                 while the address is parsed, so it may be modified even if
+ *                 decoding fails.
  *       prog_len: Pointer to a size_t that will be updated to contain the length
  *                 of bytes in prog.
  *       hrp:      Pointer to the null-terminated human readable part that is
@@ -59,6 +65,28 @@ typedef enum { BECH32_ENCODING_NONE, BECH32_ENCODING_BECH32, BECH32_ENCODING_BEC
 #define BECH32M_CONST 0x2bc830a3
 #define BECH32_CONST 1
 
+/** Feed 5-bit symbols into a Bech32 checksum
+ *
+ *  In: state:   Current checksum state (1 before the first symbol).
+ *      symbols: Pointer to an array of 5-bit values.
+ *      n:       Number of entries in symbols.
+ *  Returns the updated state. After the expanded hrp, the data and six zero
+ *  symbols, the state XOR BECH32_CONST / BECH32M_CONST gives the checksum.
+ *  Symbols are consumed two at a time with a 1024-entry table unless
+ *  BCH_CHECKSUM_COMPACT is defined (default on TARGET_NANOS), which uses a
+ *  32-entry table instead (see bch_checksum.h).
+ */
+uint32_t bech32_checksum_update(uint32_t state, const uint8_t *symbols, size_t n);
+
+/** Start a Bech32 checksum from a human readable part
+ *
+ *  In: hrp:     Pointer to the human readable part (not validated).
+ *      hrp_len: Number of chars in hrp.
+ *  Returns the state after the expanded hrp (high bits of every char, a zero
+ *  separator, low bits of every char), ready for bech32_checksum_update.
+ */
+uint32_t bech32_checksum_hrp(const char *hrp, size_t hrp_len);
+
 /** Encode a Bech32 or Bech32m string
  *
  *  Out: output:  Pointer to a buffer of size strlen(hrp) + data_len + 8 that
@@ -87,4 +115,8 @@ int bech32_encode(char *output, const char *hrp, const uint8_t *data, size_t dat
  */
 bech32_encoding bech32_decode(char *hrp, uint8_t *data, size_t *data_len, const char *input);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif
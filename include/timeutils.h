@@ -24,6 +24,7 @@ extern "C" {
 
 #include "zxerror.h"
 #include "zxmacros.h"
+#include "zxtypes.h"
 
 __Z_INLINE const char *getMonth(uint8_t tm_mon) {
     switch (tm_mon) {
@@ -70,8 +71,22 @@ zxerr_t printTime(char *out, uint16_t outLen, uint64_t t);
 zxerr_t printTimeSpecialFormat(char *out, uint16_t outLen, uint64_t t);
 zxerr_t decodeTime(timedata_t *timedata, uint64_t t);
 
-// Convert seconds since epoch to UTC date
+// Convert seconds since epoch to UTC date, between years 0 and 9999
 zxerr_t extractTime(uint64_t time, timedata_t *date);
+// Same as extractTime, with negative times before 1970
+zxerr_t extractTimeSigned(int64_t time, timedata_t *date);
+
+// Longest printTimeRFC3339 output, YYYY-MM-DDTHH:MM:SS.nnnnnnnnn+HH:MM, without the terminator
+#define RFC3339_MAX_LEN 35
+// Largest timezone offset accepted by printTimeRFC3339, 23:59
+#define RFC3339_MAX_TZ_OFFSET_MINUTES 1439
+
+// Formats seconds since epoch plus nanos as an RFC 3339 timestamp in the local time of tz_offset_minutes,
+// e.g. 2024-03-09T16:05:07.120Z or 2024-03-09T18:05:07.120+02:00. precision (0 to 9) is the number of
+// fractional digits, truncated; with trimZeros set trailing zeros, and a bare '.', are dropped.
+// Returns the length written, or 0 with an empty out if the buffer is too small or an argument is invalid
+size_t printTimeRFC3339(char *out, size_t outLen, int64_t seconds, uint32_t nanos, uint8_t precision,
+                        int16_t tz_offset_minutes, bool_t trimZeros);
 
 #ifdef __cplusplus
 }
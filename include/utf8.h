@@ -63,6 +63,32 @@ typedef int32_t utf8_int32_t;
 #pragma clang diagnostic ignored "-Wcast-qual"
 #endif
 
+/* zxlib: word-at-a-time (and on hosts SSE2/SSSE3) fast paths for utf8valid, utf8nvalid, utf8len,
+ * utf8nlen, utf8size and utf8nsize_lazy. They only read the bytes before the terminator (found with
+ * strnlen) and are skipped during constant evaluation. Define UTF8_NO_FAST_PATHS to disable them. */
+#if !defined(UTF8_NO_FAST_PATHS)
+#if defined(__cplusplus) && __cplusplus >= 201402L
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define UTF8_FAST_PATHS
+#define utf8_runtime() (!__builtin_is_constant_evaluated())
+#endif
+#endif
+#else
+#define UTF8_FAST_PATHS
+#define utf8_runtime() 1
+#endif
+#endif
+
+#if defined(UTF8_FAST_PATHS)
+#include <string.h>
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -102,6 +128,123 @@ using utf8_int8_t = char8_t; /* Introduced in C++20 */
 typedef char utf8_int8_t;
 #endif
 
+#if defined(UTF8_FAST_PATHS)
+/* Number of leading bytes of str[0, n) in whole ASCII words. str[0, n) must not contain the terminator. */
+static inline size_t utf8_fast_ascii_run(const utf8_int8_t *str, size_t n) {
+    const unsigned char *s = (const unsigned char *)str;
+    uint64_t w = 0;
+    if (n < 8) {
+        return 0;
+    }
+    // Mixed text usually has short ascii runs, so check a single word before anything wider
+    memcpy(&w, s, sizeof(w));
+    if ((w & 0x8080808080808080ull) != 0) {
+        return 0;
+    }
+    size_t i = 8;
+#if defined(__SSE2__)
+    for (; i + 16 <= n; i += 16) {
+        if (_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(s + i))) != 0) {
+            break;
+        }
+    }
+#endif
+    for (; i + 8 <= n; i += 8) {
+        memcpy(&w, s + i, sizeof(w));
+        if ((w & 0x8080808080808080ull) != 0) {
+            break;
+        }
+    }
+    return i;
+}
+
+#if defined(__SSSE3__)
+/* Lookup validator after Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte",
+ * with the rules of utf8nvalid: overlong forms and leads 0xF8 to 0xFF are errors, surrogates and leads
+ * 0xF4 to 0xF7 are not. Each byte is classified together with the previous one through three nibble
+ * tables; the third and fourth bytes of a sequence are checked against the leads two and three back.
+ * Returns the start of the last codepoint before the first block with an error (or the end of the
+ * blocks), so that the scalar loop can resume there and report the exact position. */
+#define UTF8_TOO_SHORT (1 << 0)
+#define UTF8_TOO_LONG (1 << 1)
+#define UTF8_OVERLONG_3 (1 << 2)
+#define UTF8_BAD_LEAD (1 << 3)
+#define UTF8_OVERLONG_2 (1 << 5)
+#define UTF8_OVERLONG_4 (1 << 6)
+#define UTF8_TWO_CONTS (1 << 7)
+#define UTF8_CARRY (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+static inline size_t utf8_fast_valid_prefix(const utf8_int8_t *str, size_t n) {
+    const unsigned char *s = (const unsigned char *)str;
+    const __m128i byte_1_high = _mm_setr_epi8(
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        UTF8_TOO_LONG, (char)UTF8_TWO_CONTS, (char)UTF8_TWO_CONTS, (char)UTF8_TWO_CONTS, (char)UTF8_TWO_CONTS,
+        UTF8_TOO_SHORT | UTF8_OVERLONG_2, UTF8_TOO_SHORT, UTF8_TOO_SHORT | UTF8_OVERLONG_3,
+        UTF8_TOO_SHORT | UTF8_OVERLONG_4 | UTF8_BAD_LEAD);
+    const __m128i byte_1_low = _mm_setr_epi8(
+        (char)(UTF8_CARRY | UTF8_OVERLONG_2 | UTF8_OVERLONG_3 | UTF8_OVERLONG_4), (char)(UTF8_CARRY | UTF8_OVERLONG_2),
+        (char)UTF8_CARRY, (char)UTF8_CARRY, (char)UTF8_CARRY, (char)UTF8_CARRY, (char)UTF8_CARRY, (char)UTF8_CARRY,
+        (char)(UTF8_CARRY | UTF8_BAD_LEAD), (char)(UTF8_CARRY | UTF8_BAD_LEAD), (char)(UTF8_CARRY | UTF8_BAD_LEAD),
+        (char)(UTF8_CARRY | UTF8_BAD_LEAD), (char)(UTF8_CARRY | UTF8_BAD_LEAD), (char)(UTF8_CARRY | UTF8_BAD_LEAD),
+        (char)(UTF8_CARRY | UTF8_BAD_LEAD), (char)(UTF8_CARRY | UTF8_BAD_LEAD));
+    const char cont = (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_BAD_LEAD);
+    const char lead = UTF8_TOO_SHORT | UTF8_BAD_LEAD;
+    const __m128i byte_2_high = _mm_setr_epi8(
+        lead, lead, lead, lead, lead, lead, lead, lead, (char)(cont | UTF8_OVERLONG_3 | UTF8_OVERLONG_4),
+        (char)(cont | UTF8_OVERLONG_3), cont, cont, lead, lead, lead, lead);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i high_bit = _mm_set1_epi8((char)0x80);
+    const __m128i incomplete_max = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)0xEF,
+                                                 (char)0xDF, (char)0xBF);
+
+    __m128i prev = _mm_setzero_si128();
+    __m128i prev_incomplete = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i input = _mm_loadu_si128((const __m128i *)(s + i));
+        __m128i error;
+        if (_mm_movemask_epi8(input) == 0) {
+            // ASCII block: only an unfinished sequence at the end of the previous one can fail
+            error = prev_incomplete;
+        } else {
+            const __m128i prev1 = _mm_alignr_epi8(input, prev, 15);
+            const __m128i sc = _mm_and_si128(
+                _mm_and_si128(_mm_shuffle_epi8(byte_1_high, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+                              _mm_shuffle_epi8(byte_1_low, _mm_and_si128(prev1, nibble))),
+                _mm_shuffle_epi8(byte_2_high, _mm_and_si128(_mm_srli_epi16(input, 4), nibble)));
+            const __m128i third = _mm_subs_epu8(_mm_alignr_epi8(input, prev, 14), _mm_set1_epi8(0xE0 - 0x80));
+            const __m128i fourth = _mm_subs_epu8(_mm_alignr_epi8(input, prev, 13), _mm_set1_epi8(0xF0 - 0x80));
+            const __m128i must_be_cont = _mm_and_si128(_mm_or_si128(third, fourth), high_bit);
+            error = _mm_xor_si128(must_be_cont, sc);
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xFFFF) {
+            break;
+        }
+        prev_incomplete = _mm_subs_epu8(input, incomplete_max);
+        prev = input;
+    }
+
+    size_t start = i;
+    while (start > 0 && i - start < 4) {
+        start--;
+        if ((s[start] & 0xC0) != 0x80) {
+            break;
+        }
+    }
+    return start;
+}
+
+#undef UTF8_TOO_SHORT
+#undef UTF8_TOO_LONG
+#undef UTF8_OVERLONG_3
+#undef UTF8_BAD_LEAD
+#undef UTF8_OVERLONG_2
+#undef UTF8_OVERLONG_4
+#undef UTF8_TWO_CONTS
+#undef UTF8_CARRY
+#endif
+#endif
+
 /* Return less than 0, 0, greater than 0 if src1 < src2, src1 == src2, src1 >
  * src2 respectively, case insensitive. */
 utf8_constexpr14 utf8_nonnull utf8_pure int utf8casecmp(const utf8_int8_t *src1, const utf8_int8_t *src2);
@@ -473,8 +616,15 @@ utf8_constexpr14_impl size_t utf8len(const utf8_int8_t *str) { return utf8nlen(s
 utf8_constexpr14_impl size_t utf8nlen(const utf8_int8_t *str, size_t n) {
     const utf8_int8_t *t = str;
     size_t length = 0;
+    size_t limit = n;
+#if defined(UTF8_FAST_PATHS)
+    if (utf8_runtime()) {
+        /* stop at the terminator even if the last code point is truncated, without reading past it */
+        limit = strnlen((const char *)str, n);
+    }
+#endif
 
-    while ((size_t)(str - t) < n && '\0' != *str) {
+    while ((size_t)(str - t) < limit && '\0' != *str) {
         if (0xf0 == (0xf8 & *str)) {
             /* 4-byte utf8 code point (began with 0b11110xxx) */
             str += 4;
@@ -487,6 +637,14 @@ utf8_constexpr14_impl size_t utf8nlen(const utf8_int8_t *str, size_t n) {
         } else { /* if (0x00 == (0x80 & *s)) { */
             /* 1-byte ascii (began with 0b0xxxxxxx) */
             str += 1;
+#if defined(UTF8_FAST_PATHS)
+            if (utf8_runtime() && (size_t)(str - t) + 8 <= limit && 0x00 == (0x80 & (str[-1] | *str))) {
+                /* a run of ascii, one code point per byte */
+                const size_t run = utf8_fast_ascii_run(str, limit - (size_t)(str - t));
+                str += run;
+                length += run;
+            }
+#endif
         }
 
         /* no matter the bytes we marched s forward by, it was
@@ -805,6 +963,11 @@ utf8_constexpr14_impl size_t utf8size(const utf8_int8_t *str) { return utf8size_
 utf8_constexpr14_impl size_t utf8size_lazy(const utf8_int8_t *str) { return utf8nsize_lazy(str, SIZE_MAX); }
 
 utf8_constexpr14_impl size_t utf8nsize_lazy(const utf8_int8_t *str, size_t n) {
+#if defined(UTF8_FAST_PATHS)
+    if (utf8_runtime()) {
+        return strnlen((const char *)str, n);
+    }
+#endif
     size_t size = 0;
     while (size < n && '\0' != str[size]) {
         size++;
@@ -949,6 +1112,15 @@ utf8_constexpr14_impl utf8_int8_t *utf8valid(const utf8_int8_t *str) { return ut
 utf8_constexpr14_impl utf8_int8_t *utf8nvalid(const utf8_int8_t *str, size_t n) {
     const utf8_int8_t *t = str;
     size_t consumed = 0, remained = 0;
+#if defined(UTF8_FAST_PATHS)
+    size_t limit = 0;
+    if (utf8_runtime()) {
+        limit = strnlen((const char *)str, n);
+#if defined(__SSSE3__)
+        str += utf8_fast_valid_prefix(str, limit);
+#endif
+    }
+#endif
 
     while ((void)(consumed = (size_t)(str - t)), consumed < n && '\0' != *str) {
         remained = n - consumed;
@@ -1034,6 +1206,12 @@ utf8_constexpr14_impl utf8_int8_t *utf8nvalid(const utf8_int8_t *str, size_t n)
         } else if (0x00 == (0x80 & *str)) {
             /* 1-byte ascii (began with 0b0xxxxxxx) */
             str += 1;
+#if defined(UTF8_FAST_PATHS)
+            if (utf8_runtime() && consumed + 9 <= limit && 0x00 == (0x80 & *str)) {
+                /* ascii is always valid, skip whole words of it */
+                str += utf8_fast_ascii_run(str, limit - consumed - 1);
+            }
+#endif
         } else {
             /* we have an invalid 0b1xxxxxxx utf8 code point entry */
             return (utf8_int8_t *)str;
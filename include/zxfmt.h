@@ -0,0 +1,118 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+// Lightweight formatting without snprintf.
+//
+// A zx_fmt_t cursor writes into a caller buffer through typed append calls. The buffer is kept null
+// terminated after every call. Output that does not fit is truncated, as snprintf does, and the
+// cursor remembers it so the caller can check once at the end:
+//
+//     zx_fmt_t f;
+//     zx_fmt_init(&f, out, outLen);
+//     zx_fmt_str(&f, " [");
+//     zx_fmt_u64(&f, pageIdx + 1, 0);
+//     zx_fmt_char(&f, '/');
+//     zx_fmt_u64(&f, pageCount, 0);
+//     zx_fmt_char(&f, ']');
+//     return zx_fmt_status(&f);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zxerror.h"
+#include "zxmacros.h"
+#include "zxtypes.h"
+
+typedef struct {
+    char *buf;
+    uint16_t size;  // bytes in buf, including the terminator
+    uint16_t len;
+    bool_t overflow;
+} zx_fmt_t;
+
+// Starts an empty string in buf. Sizes above UINT16_MAX are clamped
+void zx_fmt_init(zx_fmt_t *f, char *buf, size_t size);
+
+void zx_fmt_str(zx_fmt_t *f, const char *s);
+// Appends at most n characters of s, stopping early at a terminator
+void zx_fmt_strn(zx_fmt_t *f, const char *s, size_t n);
+void zx_fmt_char(zx_fmt_t *f, char c);
+void zx_fmt_repeat(zx_fmt_t *f, char c, uint16_t count);
+
+// Decimal, left padded with zeros to width digits (0 for no padding)
+void zx_fmt_u64(zx_fmt_t *f, uint64_t value, uint8_t width);
+void zx_fmt_i64(zx_fmt_t *f, int64_t value);
+// Hexadecimal without prefix, left padded with zeros to width digits
+void zx_fmt_hex(zx_fmt_t *f, uint64_t value, uint8_t width, bool_t uppercase);
+// value / 10^decimals with all decimals printed ("0.050", "12.345")
+void zx_fmt_fixed(zx_fmt_t *f, uint64_t value, uint8_t decimals);
+
+__Z_INLINE zxerr_t zx_fmt_status(const zx_fmt_t *f) { return f->overflow ? zxerr_buffer_too_small : zxerr_ok; }
+
+// Replaces snprintf(dst, dstSize, "%s", src). Returns the length written
+uint16_t zx_fmt_copy(char *dst, size_t dstSize, const char *src);
+
+// Bounded string builder.
+//
+// The content lives in buf[start, start + len) and is kept null terminated. Bytes before start are
+// headroom: prefixes decided late are prepended into it without moving the content, and dropping
+// leading characters only advances start. Unlike zx_fmt_t, every operation either applies completely
+// or fails with zxerr_buffer_too_small and leaves the content untouched.
+typedef struct {
+    char *buf;
+    uint16_t size;  // bytes in buf, including the terminator
+    uint16_t start;
+    uint16_t len;
+} zx_strbuf_t;
+
+// Starts an empty string after headroom reserved bytes
+zxerr_t zx_strbuf_init(zx_strbuf_t *sb, char *buf, size_t size, uint16_t headroom);
+// Takes over the null-terminated string already at the beginning of buf
+zxerr_t zx_strbuf_wrap(zx_strbuf_t *sb, char *buf, size_t size);
+
+zxerr_t zx_strbuf_append(zx_strbuf_t *sb, const char *s, size_t n);
+zxerr_t zx_strbuf_append_str(zx_strbuf_t *sb, const char *s);
+// Uses the headroom when it is large enough, otherwise moves the content once
+zxerr_t zx_strbuf_prepend(zx_strbuf_t *sb, const char *s, size_t n);
+// Prepends c until the content is width characters long
+zxerr_t zx_strbuf_pad_left(zx_strbuf_t *sb, char c, uint16_t width);
+// Inserts c before position pos (0..len), moving whichever side of pos is shorter
+zxerr_t zx_strbuf_insert_char(zx_strbuf_t *sb, uint16_t pos, char c);
+// Drops the first n characters; they become headroom
+zxerr_t zx_strbuf_remove_prefix(zx_strbuf_t *sb, uint16_t n);
+// Keeps the first len characters
+zxerr_t zx_strbuf_truncate(zx_strbuf_t *sb, uint16_t len);
+
+__Z_INLINE const char *zx_strbuf_cstr(const zx_strbuf_t *sb) { return sb->buf + sb->start; }
+
+// Moves the content to the beginning of buf, if needed, and returns its length
+uint16_t zx_strbuf_finish(zx_strbuf_t *sb);
+
+// Number of decimal digits of value
+uint8_t zx_fmt_dec_len(uint64_t value);
+// Writes the decimal digits of value so that the last one lands just before end. No terminator
+void zx_fmt_dec_write(char *end, uint64_t value);
+// Writes exactly width digits of value, zero padded and keeping the lowest ones. No terminator
+void zx_fmt_dec_fixed(char *dst, uint32_t value, uint8_t width);
+
+#ifdef __cplusplus
+}
+#endif
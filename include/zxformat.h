@@ -21,40 +21,29 @@ extern "C" {
 
 #include <stdbool.h>
 
+#include "hexutils.h"
 #include "zxerror.h"
+#include "zxfmt.h"
 #include "zxmacros.h"
+#include "zxswar.h"
 
 #define IS_PRINTABLE(c) (c >= 0x20 && c <= 0x7e)
 
-#define NUM_TO_STR(TYPE)                                                             \
-    __Z_INLINE const char *TYPE##_to_str(char *data, int dataLen, TYPE##_t number) { \
-        if (dataLen < 2) return "Buffer too small";                                  \
-        MEMZERO(data, dataLen);                                                      \
-        char *p = data;                                                              \
-        if (number < 0) {                                                            \
-            *(p++) = '-';                                                            \
-            data++;                                                                  \
-        } else if (number == 0) {                                                    \
-            *(p++) = '0';                                                            \
-        }                                                                            \
-        TYPE##_t tmp;                                                                \
-        while (number != 0) {                                                        \
-            if (p - data >= (dataLen - 1)) {                                         \
-                return "Buffer too small";                                           \
-            }                                                                        \
-            tmp = number % 10;                                                       \
-            tmp = tmp < 0 ? -tmp : tmp;                                              \
-            *(p++) = (char)('0' + tmp);                                              \
-            number /= 10;                                                            \
-        }                                                                            \
-        while (p > data) {                                                           \
-            p--;                                                                     \
-            char z = *data;                                                          \
-            *data = *p;                                                              \
-            *p = z;                                                                  \
-            data++;                                                                  \
-        }                                                                            \
-        return NULL;                                                                 \
+// Write the decimal representation of number, null terminated, and return its length.
+// Returns 0, with data zeroed, if it does not fit in dataLen bytes.
+uint16_t uint32_to_str_len(char *data, uint16_t dataLen, uint32_t number);
+uint16_t uint64_to_str_len(char *data, uint16_t dataLen, uint64_t number);
+uint16_t int32_to_str_len(char *data, uint16_t dataLen, int32_t number);
+uint16_t int64_to_str_len(char *data, uint16_t dataLen, int64_t number);
+
+#define NUM_TO_STR(TYPE)                                                                                     \
+    __Z_INLINE const char *TYPE##_to_str(char *data, int dataLen, TYPE##_t number) {                         \
+        if (dataLen < 2) return "Buffer too small";                                                          \
+        MEMZERO(data, dataLen);                                                                              \
+        if (TYPE##_to_str_len(data, (uint16_t)(dataLen > UINT16_MAX ? UINT16_MAX : dataLen), number) == 0) { \
+            return "Buffer too small";                                                                       \
+        }                                                                                                    \
+        return NULL;                                                                                         \
     }
 
 NUM_TO_STR(int32)
@@ -69,52 +58,20 @@ size_t z_strlen(const char *buffer, size_t maxSize);
 
 zxerr_t z_str3join(char *buffer, size_t bufferSize, const char *prefix, const char *suffix);
 
-__Z_INLINE void bip32_to_str(char *s, uint32_t max, const uint32_t *path, uint8_t pathLen) {
-    MEMZERO(s, max);
-
-    if (pathLen == 0) {
-        snprintf(s, max, "EMPTY PATH");
-        return;
-    }
-
-    if (pathLen > 5) {
-        snprintf(s, max, "ERROR");
-        return;
-    }
-
-    uint32_t offset = 0;
-    for (uint16_t i = 0; i < pathLen; i++) {
-        size_t written;
+// Write a derivation path as "44'/60'/0'/0/1", null terminated, and return its length.
+// Any depth is accepted; hardened components get a "'" suffix. An empty path is written as "EMPTY PATH".
+// Returns 0, with s zeroed, if the output does not fit in max bytes.
+uint16_t bip32_to_str_len(char *s, uint16_t max, const uint32_t *path, uint8_t pathLen);
 
-        // Warning: overcomplicated because Ledger's snprintf does not return number of written bytes
+// Paths deeper than this are rejected by bip32_to_str, use bip32_to_str_len for those
+#define BIP32_TO_STR_MAX_PATH_LEN 5
 
-        snprintf(s + offset, max - offset, "%d", path[i] & 0x7FFFFFFFu);
-        written = strnlen(s + offset, max - offset);
-        if (written == 0 || written >= max - offset) {
-            snprintf(s, max, "ERROR");
-            return;
-        }
-        offset += written;
-
-        if ((path[i] & 0x80000000u) != 0) {
-            snprintf(s + offset, max - offset, "'");
-            written = strnlen(s + offset, max - offset);
-            if (written == 0 || written >= max - offset) {
-                snprintf(s, max, "ERROR");
-                return;
-            }
-            offset += written;
-        }
+__Z_INLINE void bip32_to_str(char *s, uint32_t max, const uint32_t *path, uint8_t pathLen) {
+    MEMZERO(s, max);
 
-        if (i != pathLen - 1) {
-            snprintf(s + offset, max - offset, "/");
-            written = strnlen(s + offset, max - offset);
-            if (written == 0 || written >= max - offset) {
-                snprintf(s, max, "ERROR");
-                return;
-            }
-            offset += written;
-        }
+    if (pathLen > BIP32_TO_STR_MAX_PATH_LEN ||
+        bip32_to_str_len(s, (uint16_t)(max > UINT16_MAX ? UINT16_MAX : max), path, pathLen) == 0) {
+        zx_fmt_copy(s, max, "ERROR");
     }
 }
 
@@ -232,6 +189,13 @@ __Z_INLINE int64_t str_to_int64(const char *start, const char *end, char *error)
     return (int64_t)value;
 }
 
+// Turns the decimal integer string held by sb into a fixed point string with decimalPlaces decimals:
+// leading zeros are dropped and short values are zero padded ("5" -> "0.005"). The leading zeros become
+// headroom, so a later zx_strbuf_prepend usually does not move the digits.
+zxerr_t intstr_to_fpstr_sb(zx_strbuf_t *sb, uint16_t decimalPlaces);
+// Drops trailing fractional zeros, keeping at least non_trimmed decimals (see number_inplace_trimming)
+void number_trimming_sb(zx_strbuf_t *sb, uint8_t non_trimmed);
+
 uint8_t intstr_to_fpstr_inplace(char *number, size_t number_max_size, uint8_t decimalPlaces);
 zxerr_t insertDecimalPoint(char *output, uint16_t outputLen, uint16_t decimalPlaces);
 
@@ -241,59 +205,49 @@ __Z_INLINE uint8_t fpstr_to_str(char *out, uint16_t outLen, const char *number,
 
     if (decimals == 0) {
         if (digits == 0) {
-            snprintf(out, outLen, "0");
+            zx_fmt_copy(out, outLen, "0");
             return 0;
         }
 
         if (outLen < digits) {
-            snprintf(out, outLen, "ERR");
+            zx_fmt_copy(out, outLen, "ERR");
             return 1;
         }
 
         // No need for formatting
-        snprintf(out, outLen, "%s", number);
+        zx_fmt_copy(out, outLen, number);
         return 0;
     }
 
     if ((outLen < decimals + 2)) {
-        snprintf(out, outLen, "ERR");
+        zx_fmt_copy(out, outLen, "ERR");
         return 1;
     }
 
     if (outLen < digits + 2) {
-        snprintf(out, outLen, "ERR");
+        zx_fmt_copy(out, outLen, "ERR");
         return 1;
     }
 
+    zx_fmt_t f;
+    zx_fmt_init(&f, out, outLen);
+
     if (digits <= decimals) {
         if (outLen <= decimals + 2) {
-            snprintf(out, outLen, "ERR");
+            zx_fmt_copy(out, outLen, "ERR");
             return 1;
         }
 
-        // First part
-        snprintf(out, outLen, "0.");
-        out += 2;
-        outLen -= 2;
-
-        MEMSET(out, '0', decimals - digits);
-        out += decimals - digits;
-        outLen -= decimals - digits;
-
-        snprintf(out, outLen, "%s", number);
+        zx_fmt_str(&f, "0.");
+        zx_fmt_repeat(&f, '0', (uint16_t)(decimals - digits));
+        zx_fmt_str(&f, number);
         return 0;
     }
 
     const size_t shift = digits - decimals;
-    snprintf(out, outLen, "%s", number);
-    number += shift;
-
-    out += shift;
-    outLen -= shift;
-
-    *out++ = '.';
-    outLen--;
-    snprintf(out, outLen, "%s", number);
+    zx_fmt_strn(&f, number, shift);
+    zx_fmt_char(&f, '.');
+    zx_fmt_str(&f, number + shift);
     return 0;
 }
 
@@ -336,18 +290,22 @@ __Z_INLINE uint64_t uint64_from_BEarray(const uint8_t data[8]) {
     return result;
 }
 
+#if !defined(ZXFORMAT_HEX_COMPACT) && defined(TARGET_NANOS)
+#define ZXFORMAT_HEX_COMPACT
+#endif
+
+// Writes 2 * count hex characters (no terminator). ZXFORMAT_HEX_COMPACT (default on TARGET_NANOS)
+// replaces the 1 KB two-character tables with a 16-character nibble table.
+void array_to_hexchars(char *dst, const uint8_t *src, size_t count, bool uppercase);
+
 __Z_INLINE uint32_t array_to_hexstr(char *dst, uint16_t dstLen, const uint8_t *src, uint16_t count) {
     MEMZERO(dst, dstLen);
     if (dstLen < (count * 2 + 1)) {
         return 0;
     }
 
-    const char hexchars[] = "0123456789abcdef";
-    for (uint16_t i = 0; i < count; i++, src++) {
-        *dst++ = hexchars[*src >> 4u];
-        *dst++ = hexchars[*src & 0x0Fu];
-    }
-    *dst = 0;  // terminate string
+    array_to_hexchars(dst, src, count, false);
+    dst[count * 2] = 0;  // terminate string
 
     return (uint32_t)(count * 2);
 }
@@ -358,31 +316,19 @@ __Z_INLINE uint32_t array_to_hexstr_uppercase(char *dst, uint16_t dstLen, const
         return 0;
     }
 
-    const char hexchars[] = "0123456789ABCDEF";
-    for (uint16_t i = 0; i < count; i++, src++) {
-        *dst++ = hexchars[*src >> 4u];
-        *dst++ = hexchars[*src & 0x0Fu];
-    }
-    *dst = 0;  // terminate string
+    array_to_hexchars(dst, src, count, true);
+    dst[count * 2] = 0;  // terminate string
 
     return (uint32_t)(count * 2);
 }
 
 __Z_INLINE uint32_t hexstr_to_array(uint8_t *dst, uint16_t dstLen, const char *src, const uint16_t srcLen) {
     MEMZERO(dst, dstLen);
-    if (srcLen % 2 != 0 || dstLen < srcLen / 2) {
-        return 0;
+    const size_t len = parseHexStringExt(dst, dstLen, src, srcLen);
+    if (len == 0) {
+        MEMZERO(dst, dstLen);
     }
-
-    for (size_t i = 0; i < srcLen / 2; i++) {
-        uint8_t ch0 = src[2 * i];
-        uint8_t ch1 = src[2 * i + 1];
-        uint8_t nib0 = (ch0 & 0xF) + (ch0 >> 6) | ((ch0 >> 3) & 0x8);
-        uint8_t nib1 = (ch1 & 0xF) + (ch1 >> 6) | ((ch1 >> 3) & 0x8);
-        dst[i] = (nib0 << 4) | nib1;
-    }
-
-    return srcLen / 2;
+    return (uint32_t)len;
 }
 
 __Z_INLINE zxerr_t to_uppercase(uint8_t *letter) {
@@ -411,10 +357,7 @@ __Z_INLINE zxerr_t array_to_uppercase(uint8_t *input, uint16_t inputLen) {
     if (input == NULL) {
         return zxerr_no_data;
     }
-
-    for (uint16_t i = 0; i < inputLen; i++) {
-        to_uppercase(input + i);
-    }
+    zx_swar_to_upper(input, inputLen);
     return zxerr_ok;
 }
 
@@ -422,42 +365,38 @@ __Z_INLINE zxerr_t array_to_lowercase(uint8_t *input, uint16_t inputLen) {
     if (input == NULL) {
         return zxerr_no_data;
     }
-
-    for (uint16_t i = 0; i < inputLen; i++) {
-        to_lowercase(input + i);
-    }
+    zx_swar_to_lower(input, inputLen);
     return zxerr_ok;
 }
 
-__Z_INLINE void pageStringExt(char *outValue, uint16_t outValueLen, const char *inValue, uint16_t inValueLen,
-                              uint8_t pageIdx, uint8_t *pageCount) {
-    MEMZERO(outValue, outValueLen);
-    *pageCount = 0;
-
-    outValueLen--;  // leave space for NULL termination
-    if (outValueLen == 0) {
-        return;
-    }
-
-    if (inValueLen == 0) {
-        return;
-    }
-
-    *pageCount = (uint8_t)(inValueLen / outValueLen);
-    const uint16_t lastChunkLen = (inValueLen % outValueLen);
-
-    if (lastChunkLen > 0) {
-        (*pageCount)++;
-    }
-
-    if (pageIdx < *pageCount) {
-        if (lastChunkLen > 0 && pageIdx == *pageCount - 1) {
-            MEMCPY(outValue, inValue + (pageIdx * outValueLen), lastChunkLen);
-        } else {
-            MEMCPY(outValue, inValue + (pageIdx * outValueLen), outValueLen);
-        }
-    }
-}
+// Page layout of a string shown outValueLen - 1 bytes at a time.
+//
+// Page boundaries are moved back to the start of a UTF-8 codepoint so that no page splits a character.
+// The layout is computed once by page_table_init and the table can be kept across page requests, so
+// fetching page k is a single copy. Page k starts at k * pageLen minus the bytes (0 to 3) that the
+// previous boundaries were moved back by; those are packed two bits per page with a running total per
+// word. When no boundary had to move (always the case for ASCII) the closed form is used directly.
+#define PAGE_TABLE_WORDS 16  // 16 pages per word, enough for the 255 pages pageCount can express
+
+typedef struct {
+    const char *data;
+    uint16_t dataLen;
+    uint16_t pageLen;
+    uint8_t pageCount;
+    bool_t uniform;
+    uint32_t shifts[PAGE_TABLE_WORDS];
+    uint16_t shiftBase[PAGE_TABLE_WORDS];
+} page_table_t;
+
+void page_table_init(page_table_t *pt, const char *data, uint16_t dataLen, uint16_t outValueLen);
+// Writes page pageIdx, null terminated, to outValue (outValueLen as given to page_table_init).
+// Pages beyond pageCount leave outValue empty.
+void page_table_get(const page_table_t *pt, char *outValue, uint16_t outValueLen, uint8_t pageIdx);
+
+// One-shot version of page_table_init + page_table_get: walks the page boundaries up to the end of the
+// string without storing them
+void pageStringExt(char *outValue, uint16_t outValueLen, const char *inValue, uint16_t inValueLen, uint8_t pageIdx,
+                   uint8_t *pageCount);
 
 __Z_INLINE void pageString(char *outValue, uint16_t outValueLen, const char *inValue, uint8_t pageIdx,
                            uint8_t *pageCount) {
@@ -495,43 +434,22 @@ __Z_INLINE void pageStringHex(char *outValue, uint16_t outValueLen, const char *
     }
 }
 
-__Z_INLINE zxerr_t formatBufferData(const uint8_t *ptr, uint64_t len, char *outValue, uint16_t outValueLen,
-                                    uint8_t pageIdx, uint8_t *pageCount) {
-    char bufferUI[500 + 1];
-    MEMZERO(bufferUI, sizeof(bufferUI));
-    MEMZERO(outValue, outValueLen);
-    CHECK_APP_CANARY()
-
-    if (len >= sizeof(bufferUI)) {
-        return zxerr_buffer_too_small;
-    }
-    memcpy(bufferUI, ptr, len);
-
-    // Check we have all ascii
-    uint8_t allAscii = 1;
-    for (size_t i = 0; i < len && allAscii; i++) {
-        if (bufferUI[i] < 32 || bufferUI[i] > 127) {
-            allAscii = 0;
-        }
-    }
-
-    if (!allAscii) {
-        bufferUI[0] = '0';
-        bufferUI[1] = 'x';
-        if (array_to_hexstr(bufferUI + 2, sizeof(bufferUI) - 2, ptr, len) == 0) {
-            return zxerr_buffer_too_small;
-        }
-    }
-
-    pageString(outValue, outValueLen, bufferUI, pageIdx, pageCount);
-
-    return zxerr_ok;
-}
+// Renders page pageIdx of len bytes of data without staging them: printable ASCII data (bytes 32 to 127)
+// is shown as is, anything else as "0x" followed by lowercase hex. The page count is computed from the
+// length and only the requested page is copied or hex encoded, so there is no size cap other than the
+// 255 pages pageCount can express (zxerr_buffer_too_small beyond that).
+zxerr_t formatBufferData(const uint8_t *ptr, uint64_t len, char *outValue, uint16_t outValueLen, uint8_t pageIdx,
+                         uint8_t *pageCount);
 
 size_t asciify(char *utf8_in);
 
 size_t asciify_ext(const char *utf8_in, char *ascii_only_out);
 
+// Transliterates len bytes of UTF-8 to ASCII in a single pass: codepoints 32 to 127 are kept and every other
+// codepoint becomes '.'. ascii_only_out needs len + 1 bytes and may be utf8_in itself. If the input is not
+// valid UTF-8 the output is empty. Returns the output length.
+size_t asciify_ext_n(const char *utf8_in, size_t len, char *ascii_only_out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,46 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+// Byte scans and transforms that work on a machine word (8 bytes, 4 on 32-bit targets) at a time.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zxtypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Index of the first byte outside [lo, hi], or len if there is none. hi must be at most 0x7F.
+size_t zx_swar_find_outside(const uint8_t *data, size_t len, uint8_t lo, uint8_t hi);
+
+// Index of the first byte that is not printable ASCII (0x20 to 0x7E, see IS_PRINTABLE), or len
+size_t zx_swar_find_non_printable(const uint8_t *data, size_t len);
+
+bool_t zx_swar_all_printable(const uint8_t *data, size_t len);
+
+// Index of the first zero byte, or len
+size_t zx_swar_find_zero(const uint8_t *data, size_t len);
+
+// ASCII case folding in place; bytes that are not ASCII letters are left untouched
+void zx_swar_to_upper(uint8_t *data, size_t len);
+void zx_swar_to_lower(uint8_t *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -39,17 +39,16 @@ unsigned char const BASE58ALPHABET[] = {'1', '2', '3', '4', '5', '6', '7', '8',
                                         'X', 'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'm',
                                         'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z'};
 
-int decode_base58(const char *in, size_t length, unsigned char *out, size_t *outlen) {
-    unsigned char tmp[MAX_DEC_INPUT_SIZE];
-    unsigned char buffer[MAX_DEC_INPUT_SIZE] = {0};
-    unsigned char i;
-    unsigned char j;
-    unsigned char startAt;
-    unsigned char zeroCount = 0;
-    if (length > MAX_DEC_INPUT_SIZE) {
-        return -1;
-    }
-    MEMMOVE(tmp, in, length);
+// Runs the byte-at-a-time division over the digits kept in tmp (length bytes)
+// and writes the result right-aligned into buffer. On success the decoded
+// bytes are buffer[*start .. bufferLen).
+static int base58_decode_core(const char *in, size_t length, unsigned char *tmp, unsigned char *buffer,
+                              size_t bufferLen, size_t *start) {
+    size_t i;
+    size_t j;
+    size_t startAt;
+    size_t zeroCount = 0;
+
     for (i = 0; i < length; i++) {
         if ((unsigned long)in[i] >= sizeof(BASE58TABLE)) {
             return -1;
@@ -62,91 +61,664 @@ int decode_base58(const char *in, size_t length, unsigned char *out, size_t *out
     while ((zeroCount < length) && (tmp[zeroCount] == 0)) {
         ++zeroCount;
     }
-    j = length;
+    j = bufferLen;
     startAt = zeroCount;
     while (startAt < length) {
         unsigned short remainder = 0;
-        unsigned char divLoop;
+        size_t divLoop;
         for (divLoop = startAt; divLoop < length; divLoop++) {
             unsigned short digit256 = (unsigned short)(tmp[divLoop] & 0xff);
             unsigned short tmpDiv = remainder * 58 + digit256;
             tmp[divLoop] = (unsigned char)(tmpDiv / 256);
             remainder = (tmpDiv % 256);
         }
-        if (tmp[startAt] == 0) {
+        // Skipping every exhausted digit ends the loop on the most significant
+        // byte, so no zero bytes are emitted that would have to be trimmed
+        while (startAt < length && tmp[startAt] == 0) {
             ++startAt;
         }
-        // Base58 output never has more digits than the input, so j (starting at
-        // length) cannot reach 0 here. The explicit guard proves that bound to the
-        // static analyzer and avoids an unsigned underflow of j on any future change.
+        // Base58 output never has more bytes than the input has digits, so this
+        // only triggers when bufferLen < length and the result does not fit
         if (j == 0) {
-            break;
+            return -1;
         }
         buffer[--j] = (unsigned char)remainder;
     }
-    while ((j < length) && (buffer[j] == 0)) {
-        ++j;
+    if (j < zeroCount) {
+        return -1;
     }
-    length = length - (j - zeroCount);
-    if (*outlen < length) {
+    j -= zeroCount;
+    MEMZERO(buffer + j, zeroCount);
+    *start = j;
+    return 0;
+}
+
+int decode_base58_ex(const char *in, size_t length, unsigned char *out, size_t *outlen, unsigned char *scratch,
+                     size_t scratchLen) {
+    size_t start = 0;
+    if (scratch == NULL || scratchLen < BASE58_DECODE_SCRATCH_LEN(length)) {
         return -1;
     }
 
-    MEMMOVE(out, buffer + j - zeroCount, length);
+    // The result is built right-aligned in out and then moved to the front
+    if (base58_decode_core(in, length, scratch, out, *outlen, &start) != 0) {
+        return -1;
+    }
+    length = *outlen - start;
+    MEMMOVE(out, out + start, length);
     *outlen = length;
     return 0;
 }
 
+int decode_base58(const char *in, size_t length, unsigned char *out, size_t *outlen) {
+    unsigned char tmp[MAX_DEC_INPUT_SIZE];
+    if (length > MAX_DEC_INPUT_SIZE) {
+        return -1;
+    }
+
+    // Strings in these ranges usually hold a 32- or 64-byte value. If the kernel
+    // rejects them, fall through so that errors and other sizes behave as before.
+    if (length >= BASE58_32_MIN_ENCODED_LEN && length <= BASE58_32_MAX_ENCODED_LEN &&
+        decode_base58_32(in, length, out, outlen) == 0) {
+        return 0;
+    }
+    if (length >= BASE58_64_MIN_ENCODED_LEN && length <= BASE58_64_MAX_ENCODED_LEN &&
+        decode_base58_64(in, length, out, outlen) == 0) {
+        return 0;
+    }
+
+    return decode_base58_ex(in, length, out, outlen, tmp, sizeof(tmp));
+}
+
+// 58^5 fits in 30 bits, so a limb shifted left by 32 plus the incoming carry
+// still fits in a uint64_t accumulator
+#define BASE58_LIMB_BASE 656356768u  // 58^5
+#define BASE58_LIMB_DIGITS 5
+#define BASE58_LIMB_BYTES 4
+
+// Accumulates a big-endian byte stream into little-endian base 58^5 limbs.
+// Input is absorbed four bytes at a time so each pass over the limbs does a
+// single 64-by-32 division per limb instead of one per output digit. The
+// stream may be fed in several pieces (e.g. version, payload and checksum).
+typedef struct {
+    uint32_t *limbs;
+    size_t maxLimbs;
+    size_t used;
+    size_t zeroCount;
+    uint32_t word;
+    uint8_t wordBytes;
+    uint8_t leading;
+} base58_limbs_ctx_t;
+
+static void base58_limbs_init(base58_limbs_ctx_t *ctx, uint32_t *limbs, size_t maxLimbs) {
+    ctx->limbs = limbs;
+    ctx->maxLimbs = maxLimbs;
+    ctx->used = 0;
+    ctx->zeroCount = 0;
+    ctx->word = 0;
+    ctx->wordBytes = 0;
+    ctx->leading = 1;
+}
+
+// limbs = limbs * 2^(8 * bytes) + word
+static int base58_limbs_absorb(base58_limbs_ctx_t *ctx, uint32_t word, uint8_t bytes) {
+    uint64_t carry = word;
+    for (size_t i = 0; i < ctx->used; i++) {
+        const uint64_t acc = ((uint64_t)ctx->limbs[i] << (8u * bytes)) + carry;
+        carry = acc / BASE58_LIMB_BASE;
+        ctx->limbs[i] = (uint32_t)(acc - carry * BASE58_LIMB_BASE);
+    }
+    while (carry != 0) {
+        if (ctx->used >= ctx->maxLimbs) {
+            return -1;
+        }
+        ctx->limbs[ctx->used++] = (uint32_t)(carry % BASE58_LIMB_BASE);
+        carry /= BASE58_LIMB_BASE;
+    }
+    return 0;
+}
+
+static int base58_limbs_update(base58_limbs_ctx_t *ctx, const unsigned char *in, size_t length) {
+    size_t pos = 0;
+
+    // Leading zero bytes are emitted as '1' and never reach the limbs
+    while (ctx->leading && pos < length && in[pos] == 0) {
+        ctx->zeroCount++;
+        pos++;
+    }
+    if (pos < length) {
+        ctx->leading = 0;
+    }
+
+    while (pos < length) {
+        if (ctx->wordBytes == 0 && length - pos >= BASE58_LIMB_BYTES) {
+            const uint32_t word = ((uint32_t)in[pos] << 24u) | ((uint32_t)in[pos + 1] << 16u) |
+                                  ((uint32_t)in[pos + 2] << 8u) | (uint32_t)in[pos + 3];
+            if (base58_limbs_absorb(ctx, word, BASE58_LIMB_BYTES) != 0) {
+                return -1;
+            }
+            pos += BASE58_LIMB_BYTES;
+            continue;
+        }
+
+        ctx->word = (ctx->word << 8u) | in[pos++];
+        ctx->wordBytes++;
+        if (ctx->wordBytes == BASE58_LIMB_BYTES) {
+            if (base58_limbs_absorb(ctx, ctx->word, BASE58_LIMB_BYTES) != 0) {
+                return -1;
+            }
+            ctx->word = 0;
+            ctx->wordBytes = 0;
+        }
+    }
+    return 0;
+}
+
+// Number of base58 digits needed to print the limbs, without leading zeros
+static size_t base58_limbs_digits(const uint32_t *limbs, size_t used) {
+    if (used == 0) {
+        return 0;
+    }
+    size_t digits = (used - 1) * BASE58_LIMB_DIGITS;
+    for (uint32_t top = limbs[used - 1]; top != 0; top /= 58) {
+        digits++;
+    }
+    return digits;
+}
+
+// Writes the limbs as base58 characters, right to left, ending at out + digits
+static void base58_limbs_to_chars(const uint32_t *limbs, size_t used, unsigned char *out, size_t digits) {
+    unsigned char *p = out + digits;
+    for (size_t i = 0; i < used && p > out; i++) {
+        uint32_t limb = limbs[i];
+        for (uint8_t d = 0; d < BASE58_LIMB_DIGITS && p > out; d++) {
+            *(--p) = BASE58ALPHABET[limb % 58];
+            limb /= 58;
+        }
+    }
+}
+
+// Flushes any partial word and writes the characters, same *outlen contract as encode_base58
+static int base58_limbs_final(base58_limbs_ctx_t *ctx, unsigned char *out, size_t *outlen) {
+    if (ctx->wordBytes > 0) {
+        if (base58_limbs_absorb(ctx, ctx->word, ctx->wordBytes) != 0) {
+            return -1;
+        }
+        ctx->word = 0;
+        ctx->wordBytes = 0;
+    }
+
+    const size_t digits = base58_limbs_digits(ctx->limbs, ctx->used);
+
+    if (*outlen < ctx->zeroCount + digits) {
+        *outlen = ctx->zeroCount + digits;
+        return -1;
+    }
+
+    MEMSET(out, BASE58ALPHABET[0], ctx->zeroCount);
+    base58_limbs_to_chars(ctx->limbs, ctx->used, out + ctx->zeroCount, digits);
+
+    *outlen = ctx->zeroCount + digits;
+    return 0;
+}
+
 int encode_base58(const unsigned char *in, size_t length, unsigned char *out, size_t *outlen) {
-    unsigned char buffer[MAX_ENC_INPUT_SIZE * 138 / 100 + 1] = {0};
-    MEMZERO(out, *outlen);
+    if (length == 32) {
+        return encode_base58_32(in, out, outlen);
+    }
+    if (length == 64) {
+        return encode_base58_64(in, out, outlen);
+    }
 
-    size_t i, j;
-    size_t startAt, stopAt;
-    size_t zeroCount = 0;
-    size_t outputSize;
+    uint32_t limbs[BASE58_ENCODE_SCRATCH_LIMBS(MAX_ENC_INPUT_SIZE)];
 
     if (length > MAX_ENC_INPUT_SIZE) {
+        MEMZERO(out, *outlen);
         return -1;
     }
 
-    while ((zeroCount < length) && (in[zeroCount] == 0)) {
-        ++zeroCount;
+    return encode_base58_ex(in, length, out, outlen, limbs, array_length(limbs));
+}
+
+int encode_base58_ex(const unsigned char *in, size_t length, unsigned char *out, size_t *outlen, uint32_t *scratch,
+                     size_t scratchLimbs) {
+    base58_limbs_ctx_t ctx;
+    MEMZERO(out, *outlen);
+
+    if (scratch == NULL) {
+        return -1;
+    }
+
+    base58_limbs_init(&ctx, scratch, scratchLimbs);
+    if (base58_limbs_update(&ctx, in, length) != 0) {
+        return -1;
+    }
+    return base58_limbs_final(&ctx, out, outlen);
+}
+
+int encode_base58check(const unsigned char *version, size_t versionLen, const unsigned char *payload,
+                       size_t payloadLen, size_t checksumLen, base58_checksum_fn checksum, unsigned char *out,
+                       size_t *outlen) {
+    uint32_t limbs[BASE58_ENCODE_SCRATCH_LIMBS(MAX_ENC_INPUT_SIZE)];
+    unsigned char digest[BASE58_CHECKSUM_MAX_LEN];
+    base58_limbs_ctx_t ctx;
+    MEMZERO(out, *outlen);
+
+    if (checksum == NULL || checksumLen > sizeof(digest) || versionLen > MAX_ENC_INPUT_SIZE ||
+        payloadLen > MAX_ENC_INPUT_SIZE - versionLen || checksumLen > MAX_ENC_INPUT_SIZE - versionLen - payloadLen) {
+        return -1;
+    }
+
+    if (checksum(version, versionLen, payload, payloadLen, digest, checksumLen) != 0) {
+        return -1;
+    }
+
+    // version || payload || checksum goes straight into the limbs, no combined buffer
+    base58_limbs_init(&ctx, limbs, array_length(limbs));
+    if (base58_limbs_update(&ctx, version, versionLen) != 0 || base58_limbs_update(&ctx, payload, payloadLen) != 0 ||
+        base58_limbs_update(&ctx, digest, checksumLen) != 0) {
+        return -1;
+    }
+    return base58_limbs_final(&ctx, out, outlen);
+}
+
+int decode_base58check(const char *in, size_t length, size_t checksumLen, base58_checksum_fn checksum,
+                       unsigned char *out, size_t *outlen) {
+    unsigned char tmp[MAX_DEC_INPUT_SIZE];
+    unsigned char buffer[MAX_DEC_INPUT_SIZE];
+    unsigned char digest[BASE58_CHECKSUM_MAX_LEN];
+    size_t start = 0;
+
+    if (checksum == NULL || checksumLen > sizeof(digest) || length > MAX_DEC_INPUT_SIZE) {
+        return -1;
+    }
+
+    if (base58_decode_core(in, length, tmp, buffer, length, &start) != 0) {
+        return -1;
+    }
+
+    const size_t decodedLen = length - start;
+    if (decodedLen < checksumLen) {
+        return -1;
+    }
+    const size_t dataLen = decodedLen - checksumLen;
+    if (*outlen < dataLen) {
+        return -1;
+    }
+
+    // The checksum is verified on the decoded bytes in place
+    const unsigned char *decoded = buffer + start;
+    if (checksum(decoded, dataLen, NULL, 0, digest, checksumLen) != 0 ||
+        MEMCMP(digest, decoded + dataLen, checksumLen) != 0) {
+        return -1;
+    }
+
+    MEMMOVE(out, decoded, dataLen);
+    *outlen = dataLen;
+    return 0;
+}
+
+// Fixed-width kernels for 32- and 64-byte values (public keys and signatures).
+// The radix conversion is a matrix product against precomputed tables: each
+// big-endian 32-bit word of the binary value is expanded into base 58^5 limbs
+// (encode), or each base 58^5 limb into 32-bit words (decode). Loop bounds only
+// depend on the width, never on the data.
+#define BASE58_BIN_LIMBS_32 8
+#define BASE58_RAW_LIMBS_32 9
+#define BASE58_BIN_LIMBS_64 16
+#define BASE58_RAW_LIMBS_64 18
+
+static const uint32_t BASE58_ENC_TABLE_32[BASE58_BIN_LIMBS_32][BASE58_RAW_LIMBS_32] = {
+    {0u, 513735u, 77223048u, 437087610u, 300156666u, 605448490u, 214625350u, 141436834u, 379377856u},
+    {0u, 0u, 78508u, 646269101u, 118408823u, 91512303u, 209184527u, 413102373u, 153715680u},
+    {0u, 0u, 0u, 11997u, 486083817u, 3737691u, 294005210u, 247894721u, 289024608u},
+    {0u, 0u, 0u, 0u, 1833u, 324463681u, 385795061u, 551597588u, 21339008u},
+    {0u, 0u, 0u, 0u, 0u, 280u, 127692781u, 389432875u, 357132832u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 42u, 537767569u, 410450016u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 6u, 356826688u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 1u},
+};
+
+static const uint32_t BASE58_DEC_TABLE_32[BASE58_RAW_LIMBS_32][BASE58_BIN_LIMBS_32] = {
+    {1277u, 2650397687u, 3801011509u, 2074386530u, 3248244966u, 687255411u, 2959155456u, 0u},
+    {0u, 8360u, 1184754854u, 3047609191u, 3418394749u, 132556120u, 1199103528u, 0u},
+    {0u, 0u, 54706u, 2996985344u, 1834629191u, 3964963911u, 485140318u, 1073741824u},
+    {0u, 0u, 0u, 357981u, 1476998812u, 3337178590u, 1483338760u, 4194304000u},
+    {0u, 0u, 0u, 0u, 2342503u, 3052466824u, 2595180627u, 17825792u},
+    {0u, 0u, 0u, 0u, 0u, 15328518u, 1933902296u, 4063920128u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 100304420u, 3355157504u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 656356768u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 1u},
+};
+
+static const uint32_t BASE58_ENC_TABLE_64[BASE58_BIN_LIMBS_64][BASE58_RAW_LIMBS_64] = {
+    {0u, 2631u, 149457141u, 577092685u, 632289089u, 81912456u, 221591423u, 502967496u, 403284731u, 377738089u,
+     492128779u, 746799u, 366351977u, 190199623u, 38066284u, 526403762u, 650603058u, 454901440u},
+    {0u, 0u, 402u, 68350375u, 30641941u, 266024478u, 208884256u, 571208415u, 337765723u, 215140626u, 129419325u,
+     480359048u, 398051646u, 635841659u, 214020719u, 136986618u, 626219915u, 49699360u},
+    {0u, 0u, 0u, 61u, 295059608u, 141201404u, 517024870u, 239296485u, 527697587u, 212906911u, 453637228u, 467589845u,
+     144614682u, 45134568u, 184514320u, 644355351u, 104784612u, 308625792u},
+    {0u, 0u, 0u, 0u, 9u, 256449755u, 500124311u, 479690581u, 372802935u, 413254725u, 487877412u, 520263169u,
+     176791855u, 78190744u, 291820402u, 74998585u, 496097732u, 59100544u},
+    {0u, 0u, 0u, 0u, 0u, 1u, 285573662u, 455976778u, 379818553u, 100001224u, 448949512u, 109507367u, 117185012u,
+     347328982u, 522665809u, 36908802u, 577276849u, 64504928u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 143945778u, 651677945u, 281429047u, 535878743u, 264290972u, 526964023u, 199595821u,
+     597442702u, 499113091u, 424550935u, 458949280u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 21997789u, 294590275u, 148640294u, 595017589u, 210481832u, 404203788u, 574729546u,
+     160126051u, 430102516u, 44963712u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 3361701u, 325788598u, 30977630u, 513969330u, 194569730u, 164019635u,
+     136596846u, 626087230u, 503769920u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 513735u, 77223048u, 437087610u, 300156666u, 605448490u, 214625350u,
+     141436834u, 379377856u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 78508u, 646269101u, 118408823u, 91512303u, 209184527u, 413102373u,
+     153715680u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 11997u, 486083817u, 3737691u, 294005210u, 247894721u, 289024608u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 1833u, 324463681u, 385795061u, 551597588u, 21339008u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 280u, 127692781u, 389432875u, 357132832u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 42u, 537767569u, 410450016u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 6u, 356826688u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 1u},
+};
+
+static const uint32_t BASE58_DEC_TABLE_64[BASE58_RAW_LIMBS_64][BASE58_BIN_LIMBS_64] = {
+    {249448u, 3719864065u, 173911550u, 4021557284u, 3115810883u, 2498525019u, 1035889824u, 627529458u, 3840888383u,
+     3728167192u, 2901437456u, 3863405776u, 1540739182u, 1570766848u, 0u, 0u},
+    {0u, 1632305u, 1882780341u, 4128706713u, 1023671068u, 2618421812u, 2005415586u, 1062993857u, 3577221846u,
+     3960476767u, 1695615427u, 2597060712u, 669472826u, 104923136u, 0u, 0u},
+    {0u, 0u, 10681231u, 1422956801u, 2406345166u, 4058671871u, 2143913881u, 4169135587u, 2414104418u, 2549553452u,
+     997594232u, 713340517u, 2290070198u, 1103833088u, 0u, 0u},
+    {0u, 0u, 0u, 69894212u, 1038812943u, 1785020643u, 1285619000u, 2301468615u, 3492037905u, 314610629u, 2761740102u,
+     3410618104u, 1699516363u, 910779968u, 0u, 0u},
+    {0u, 0u, 0u, 0u, 457363084u, 927569770u, 3976106370u, 1389513021u, 2107865525u, 3716679421u, 1828091393u,
+     2088408376u, 439156799u, 2579227194u, 0u, 0u},
+    {0u, 0u, 0u, 0u, 0u, 2992822783u, 383623235u, 3862831115u, 112778334u, 339767049u, 1447250220u, 486575164u,
+     3495303162u, 2209946163u, 268435456u, 0u},
+    {0u, 0u, 0u, 0u, 0u, 4u, 2404108010u, 2962826229u, 3998086794u, 1893006839u, 2266258239u, 1429430446u, 307953032u,
+     2361423716u, 176160768u, 0u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 29u, 3596590989u, 3044036677u, 1332209423u, 1014420882u, 868688145u, 4264082837u,
+     3688771808u, 2485387264u, 0u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 195u, 1054003707u, 3711696540u, 582574436u, 3549229270u, 1088536814u, 2338440092u,
+     1468637184u, 0u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 1277u, 2650397687u, 3801011509u, 2074386530u, 3248244966u, 687255411u,
+     2959155456u, 0u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 8360u, 1184754854u, 3047609191u, 3418394749u, 132556120u, 1199103528u, 0u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 54706u, 2996985344u, 1834629191u, 3964963911u, 485140318u, 1073741824u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 357981u, 1476998812u, 3337178590u, 1483338760u, 4194304000u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 2342503u, 3052466824u, 2595180627u, 17825792u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 15328518u, 1933902296u, 4063920128u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 100304420u, 3355157504u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 656356768u},
+    {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 1u},
+};
+
+static const uint32_t BASE58_LIMB_POW[BASE58_LIMB_DIGITS] = {11316496u, 195112u, 3364u, 58u, 1u};
+
+// Leading zero digits of a limb printed with BASE58_LIMB_DIGITS digits
+__Z_INLINE uint8_t base58_limb_leading_zeros(uint32_t limb) {
+    uint8_t zeros = BASE58_LIMB_DIGITS;
+    for (uint8_t d = 0; d < BASE58_LIMB_DIGITS; d++) {
+        zeros -= (uint8_t)(limb >= BASE58_LIMB_POW[d]);
+    }
+    return zeros;
+}
+
+// Carries every column into base 58^5. At most eight table rows are accumulated
+// between two calls, which keeps each uint64_t column below 2^64.
+static void base58_reduce_raw(uint64_t *raw, uint8_t rawLimbs) {
+    for (uint8_t k = rawLimbs - 1; k > 0; k--) {
+        raw[k - 1] += raw[k] / BASE58_LIMB_BASE;
+        raw[k] %= BASE58_LIMB_BASE;
+    }
+}
+
+static int base58_encode_fixed(const unsigned char *in, const uint32_t *table, uint8_t binLimbs, uint8_t rawLimbs,
+                               uint64_t *raw, unsigned char *out, size_t *outlen) {
+    MEMZERO(out, *outlen);
+    MEMZERO(raw, rawLimbs * sizeof(uint64_t));
+
+    const size_t inLen = (size_t)binLimbs * 4u;
+    const size_t rawDigits = (size_t)rawLimbs * BASE58_LIMB_DIGITS;
+
+    for (uint8_t i = 0; i < binLimbs; i++) {
+        const uint32_t word = ((uint32_t)in[4 * i] << 24u) | ((uint32_t)in[4 * i + 1] << 16u) |
+                              ((uint32_t)in[4 * i + 2] << 8u) | (uint32_t)in[4 * i + 3];
+        // Row i of the table is zero up to column i
+        for (uint8_t k = i + 1; k < rawLimbs; k++) {
+            raw[k] += (uint64_t)word * table[i * rawLimbs + k];
+        }
+        if ((i & 7u) == 7u) {
+            base58_reduce_raw(raw, rawLimbs);
+        }
+    }
+
+    // Leading zero bytes and leading zero digits are counted without early exits
+    size_t inZeros = 0;
+    uint8_t leading = 1;
+    for (size_t i = 0; i < inLen; i++) {
+        leading &= (uint8_t)(in[i] == 0);
+        inZeros += leading;
     }
 
-    outputSize = (length - zeroCount) * 138 / 100 + 1;
-    stopAt = outputSize - 1;
-    for (startAt = zeroCount; startAt < length; startAt++) {
-        int carry = in[startAt];
-        for (j = outputSize - 1; (int)j >= 0; j--) {
-            carry += 256 * buffer[j];
-            buffer[j] = carry % 58;
-            carry /= 58;
+    size_t rawZeros = 0;
+    leading = 1;
+    for (uint8_t k = 0; k < rawLimbs; k++) {
+        rawZeros += leading * base58_limb_leading_zeros((uint32_t)raw[k]);
+        leading &= (uint8_t)(raw[k] == 0);
+    }
 
-            if (j <= stopAt - 1 && carry == 0) {
-                break;
+    // Each leading zero byte maps to exactly one leading '1'
+    const size_t skip = rawZeros - inZeros;
+    if (*outlen < rawDigits - skip) {
+        *outlen = rawDigits - skip;
+        return -1;
+    }
+
+    for (uint8_t k = 0; k < rawLimbs; k++) {
+        uint32_t limb = (uint32_t)raw[k];
+        for (uint8_t d = BASE58_LIMB_DIGITS; d > 0; d--) {
+            const size_t p = (size_t)k * BASE58_LIMB_DIGITS + d - 1;
+            if (p >= skip) {
+                out[p - skip] = BASE58ALPHABET[limb % 58];
             }
+            limb /= 58;
         }
-        stopAt = j;
     }
 
-    j = 0;
-    while (j < outputSize && buffer[j] == 0) {
-        j += 1;
+    *outlen = rawDigits - skip;
+    return 0;
+}
+
+static int base58_decode_fixed(const char *in, size_t length, const uint32_t *table, uint8_t binLimbs,
+                               uint8_t rawLimbs, uint64_t *bin, unsigned char *out, size_t *outlen) {
+    const size_t outLen = (size_t)binLimbs * 4u;
+    const size_t rawDigits = (size_t)rawLimbs * BASE58_LIMB_DIGITS;
+
+    if (length == 0 || length >= rawDigits || *outlen < outLen) {
+        return -1;
+    }
+
+    size_t inOnes = 0;
+    uint8_t leading = 1;
+    for (size_t i = 0; i < length; i++) {
+        const unsigned char c = (unsigned char)in[i];
+        if (c >= sizeof(BASE58TABLE) || BASE58TABLE[c] == 0xff) {
+            return -1;
+        }
+        leading &= (uint8_t)(BASE58TABLE[c] == 0);
+        inOnes += leading;
     }
 
-    if (*outlen < zeroCount + outputSize - j) {
-        *outlen = zeroCount + outputSize - j;
+    MEMZERO(bin, binLimbs * sizeof(uint64_t));
+
+    // The input is right-aligned in rawDigits, missing digits are zero
+    const size_t pad = rawDigits - length;
+    for (uint8_t k = 0; k < rawLimbs; k++) {
+        uint32_t limb = 0;
+        for (uint8_t d = 0; d < BASE58_LIMB_DIGITS; d++) {
+            const size_t p = (size_t)k * BASE58_LIMB_DIGITS + d;
+            limb = limb * 58u + (p >= pad ? BASE58TABLE[(unsigned char)in[p - pad]] : 0u);
+        }
+        for (uint8_t j = 0; j < binLimbs; j++) {
+            bin[j] += (uint64_t)limb * table[k * binLimbs + j];
+        }
+    }
+
+    for (uint8_t j = binLimbs - 1; j > 0; j--) {
+        bin[j - 1] += bin[j] >> 32u;
+        bin[j] &= 0xFFFFFFFFu;
+    }
+    if (bin[0] > 0xFFFFFFFFu) {
+        // Value does not fit in outLen bytes
         return -1;
     }
 
-    MEMSET(out, BASE58ALPHABET[0], zeroCount);
+    size_t outZeros = 0;
+    leading = 1;
+    for (size_t i = 0; i < outLen; i++) {
+        const uint8_t b = (uint8_t)(bin[i / 4] >> (24u - 8u * (i % 4)));
+        leading &= (uint8_t)(b == 0);
+        outZeros += leading;
+    }
 
-    i = zeroCount;
-    while (j < outputSize) {
-        out[i++] = BASE58ALPHABET[buffer[j++]];
+    // Any other count means the string decodes to a different number of bytes
+    if (outZeros != inOnes) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < outLen; i++) {
+        out[i] = (uint8_t)(bin[i / 4] >> (24u - 8u * (i % 4)));
     }
-    *outlen = i;
+    *outlen = outLen;
+    return 0;
+}
+
+int encode_base58_32(const unsigned char *in, unsigned char *out, size_t *outlen) {
+    uint64_t raw[BASE58_RAW_LIMBS_32];
+    return base58_encode_fixed(in, &BASE58_ENC_TABLE_32[0][0], BASE58_BIN_LIMBS_32, BASE58_RAW_LIMBS_32, raw, out,
+                               outlen);
+}
+
+int encode_base58_64(const unsigned char *in, unsigned char *out, size_t *outlen) {
+    uint64_t raw[BASE58_RAW_LIMBS_64];
+    return base58_encode_fixed(in, &BASE58_ENC_TABLE_64[0][0], BASE58_BIN_LIMBS_64, BASE58_RAW_LIMBS_64, raw, out,
+                               outlen);
+}
+
+int decode_base58_32(const char *in, size_t length, unsigned char *out, size_t *outlen) {
+    uint64_t bin[BASE58_BIN_LIMBS_32];
+    return base58_decode_fixed(in, length, &BASE58_DEC_TABLE_32[0][0], BASE58_BIN_LIMBS_32, BASE58_RAW_LIMBS_32, bin,
+                               out, outlen);
+}
+
+int decode_base58_64(const char *in, size_t length, unsigned char *out, size_t *outlen) {
+    uint64_t bin[BASE58_BIN_LIMBS_64];
+    return base58_decode_fixed(in, length, &BASE58_DEC_TABLE_64[0][0], BASE58_BIN_LIMBS_64, BASE58_RAW_LIMBS_64, bin,
+                               out, outlen);
+}
+
+// Block base58 (CryptoNote / Monero). Every 8-byte block is encoded on its own
+// into exactly 11 characters, left-padded with '1', so the cost is linear in
+// the input and blocks do not depend on each other. A partial last block of n
+// bytes takes BASE58_BLOCK_ENCODED_SIZE[n] characters.
+#define BASE58_BLOCK_BYTES 8
+#define BASE58_BLOCK_CHARS 11
+
+static const uint8_t BASE58_BLOCK_ENCODED_SIZE[BASE58_BLOCK_BYTES + 1] = {0, 2, 3, 5, 6, 7, 9, 10, 11};
+
+size_t base58_block_encoded_len(size_t length) {
+    return (length / BASE58_BLOCK_BYTES) * BASE58_BLOCK_CHARS + BASE58_BLOCK_ENCODED_SIZE[length % BASE58_BLOCK_BYTES];
+}
+
+static void base58_block_encode(const unsigned char *in, uint8_t inLen, unsigned char *out, uint8_t outLen) {
+    uint64_t num = 0;
+    for (uint8_t i = 0; i < inLen; i++) {
+        num = (num << 8u) | in[i];
+    }
+    for (uint8_t i = outLen; i > 0; i--) {
+        out[i - 1] = BASE58ALPHABET[num % 58];
+        num /= 58;
+    }
+}
+
+static int base58_block_decode(const char *in, uint8_t inLen, unsigned char *out, uint8_t outLen) {
+    uint64_t num = 0;
+    for (uint8_t i = 0; i < inLen; i++) {
+        const unsigned char c = (unsigned char)in[i];
+        if (c >= sizeof(BASE58TABLE) || BASE58TABLE[c] == 0xff) {
+            return -1;
+        }
+        const uint8_t digit = BASE58TABLE[c];
+        if (num > (UINT64_MAX - digit) / 58) {
+            return -1;
+        }
+        num = num * 58 + digit;
+    }
+    // A partial block must fit in its byte size
+    if (outLen < BASE58_BLOCK_BYTES && (num >> (8u * outLen)) != 0) {
+        return -1;
+    }
+    for (uint8_t i = outLen; i > 0; i--) {
+        out[i - 1] = (unsigned char)num;
+        num >>= 8u;
+    }
+    return 0;
+}
+
+int encode_base58_block(const unsigned char *in, size_t length, unsigned char *out, size_t *outlen) {
+    MEMZERO(out, *outlen);
+
+    const size_t encodedLen = base58_block_encoded_len(length);
+    if (*outlen < encodedLen) {
+        *outlen = encodedLen;
+        return -1;
+    }
+
+    const size_t fullBlocks = length / BASE58_BLOCK_BYTES;
+    for (size_t b = 0; b < fullBlocks; b++) {
+        base58_block_encode(in + b * BASE58_BLOCK_BYTES, BASE58_BLOCK_BYTES, out + b * BASE58_BLOCK_CHARS,
+                            BASE58_BLOCK_CHARS);
+    }
+
+    const uint8_t lastLen = (uint8_t)(length % BASE58_BLOCK_BYTES);
+    if (lastLen > 0) {
+        base58_block_encode(in + fullBlocks * BASE58_BLOCK_BYTES, lastLen, out + fullBlocks * BASE58_BLOCK_CHARS,
+                            BASE58_BLOCK_ENCODED_SIZE[lastLen]);
+    }
+
+    *outlen = encodedLen;
+    return 0;
+}
+
+int decode_base58_block(const char *in, size_t length, unsigned char *out, size_t *outlen) {
+    const size_t fullBlocks = length / BASE58_BLOCK_CHARS;
+    const uint8_t lastChars = (uint8_t)(length % BASE58_BLOCK_CHARS);
+
+    // Map the size of the last block back to its byte count
+    uint8_t lastLen = 0;
+    while (lastLen <= BASE58_BLOCK_BYTES && BASE58_BLOCK_ENCODED_SIZE[lastLen] != lastChars) {
+        lastLen++;
+    }
+    if (lastLen > BASE58_BLOCK_BYTES) {
+        return -1;
+    }
+
+    const size_t decodedLen = fullBlocks * BASE58_BLOCK_BYTES + lastLen;
+    if (*outlen < decodedLen) {
+        return -1;
+    }
+
+    for (size_t b = 0; b < fullBlocks; b++) {
+        if (base58_block_decode(in + b * BASE58_BLOCK_CHARS, BASE58_BLOCK_CHARS, out + b * BASE58_BLOCK_BYTES,
+                                BASE58_BLOCK_BYTES) != 0) {
+            return -1;
+        }
+    }
+    if (lastLen > 0 && base58_block_decode(in + fullBlocks * BASE58_BLOCK_CHARS, lastChars,
+                                           out + fullBlocks * BASE58_BLOCK_BYTES, lastLen) != 0) {
+        return -1;
+    }
+
+    *outlen = decodedLen;
     return 0;
 }
 
@@ -20,11 +20,74 @@
 #include <stdint.h>
 #include <zxmacros.h>
 
-#include "bittools.h"
 #include "segwit_addr.h"
 
+static const char bech32_charset[] = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
+
+static uint32_t bech32_final_const(bech32_encoding enc) {
+    if (enc == BECH32_ENCODING_BECH32) return BECH32_CONST;
+    if (enc == BECH32_ENCODING_BECH32M) return BECH32M_CONST;
+    return 0;
+}
+
+// Regroups up to five input bytes (40 bits) into 5-bit symbols, returns the number of symbols
+static uint8_t bech32_group_to_symbols(const uint8_t *in, size_t chunk, uint8_t pad, uint8_t *sym) {
+    uint64_t acc = 0;
+    for (size_t i = 0; i < chunk; i++) {
+        acc = (acc << 8u) | in[i];
+    }
+
+    const uint8_t bits = (uint8_t)(chunk * 8);
+    uint8_t n = 0;
+    for (; (uint8_t)(5 * (n + 1)) <= bits; n++) {
+        sym[n] = (uint8_t)((acc >> (bits - 5 * (n + 1))) & 0x1Fu);
+    }
+    const uint8_t rem = bits - (uint8_t)(5 * n);
+    if (pad && rem > 0) {
+        sym[n++] = (uint8_t)((acc << (5 - rem)) & 0x1Fu);
+    }
+    return n;
+}
+
+// Validates the hrp and trailing bits, and computes the number of data symbols
+static zxerr_t bech32_check_params(const char *hrp, const uint8_t *in, size_t in_len, uint8_t pad, size_t max_len,
+                                   size_t *hrp_len, size_t *symbols) {
+    if (hrp == NULL || (in == NULL && in_len > 0)) {
+        return zxerr_no_data;
+    }
+
+    size_t len = 0;
+    while (hrp[len] != 0) {
+        const char ch = hrp[len];
+        if (ch < 33 || ch > 126 || (ch >= 'A' && ch <= 'Z')) {
+            return zxerr_encoding_failed;
+        }
+        len++;
+    }
+
+    if (in_len > (SIZE_MAX - 16) / 8 || len > max_len) {
+        return zxerr_out_of_bounds;
+    }
+
+    // same rule as convert_bits: without padding, the dropped trailing bits must be zero
+    const size_t rem = (in_len * 8) % 5;
+    if (!pad && rem > 0 && (in[in_len - 1] & ((1u << rem) - 1u)) != 0) {
+        return zxerr_encoding_failed;
+    }
+
+    const size_t n = (in_len * 8) / 5 + ((pad && rem > 0) ? 1 : 0);
+    if (n + 7 > max_len - len) {
+        return zxerr_out_of_bounds;
+    }
+
+    *hrp_len = len;
+    *symbols = n;
+    return zxerr_ok;
+}
+
 zxerr_t bech32EncodeFromBytes(char *out, size_t out_len, const char *hrp, const uint8_t *in, size_t in_len, uint8_t pad,
                               bech32_encoding enc) {
+    static const uint8_t zeros[6] = {0};
     MEMZERO(out, out_len);
 
     if (in_len > MAX_INPUT_SIZE) {
@@ -37,22 +100,157 @@ zxerr_t bech32EncodeFromBytes(char *out, size_t out_len, const char *hrp, const
         return zxerr_buffer_too_small;
     }
 
-    // Overestimate required size *2==(8/4) instead of *(8/5)
-    uint8_t tmp_data[MAX_INPUT_SIZE * 2];
-    size_t tmp_size = 0;
-    MEMZERO(tmp_data, sizeof(tmp_data));
-
-    if (!convert_bits(tmp_data, &tmp_size, 5, in, in_len, 8, pad)) {
+    // Invalid hrp, non-zero dropped bits and the 90-character limit all fail as encoding errors
+    size_t symbols = 0;
+    if (bech32_check_params(hrp, in, in_len, pad, BECH32_MAX_LEN, &hrplen, &symbols) != zxerr_ok) {
         return zxerr_encoding_failed;
     }
 
-    if (tmp_size >= out_len) {
-        return zxerr_out_of_bounds;
+    // Every five input bytes become eight symbols, written straight to out and absorbed into the checksum
+    MEMCPY(out, hrp, hrplen);
+    char *p = out + hrplen;
+    *(p++) = '1';
+    uint32_t chk = bech32_checksum_hrp(hrp, hrplen);
+    uint8_t sym[8];
+    for (size_t i = 0; i < in_len; i += 5) {
+        const size_t chunk = (in_len - i) < 5 ? (in_len - i) : 5;
+        const uint8_t n = bech32_group_to_symbols(in + i, chunk, pad, sym);
+        chk = bech32_checksum_update(chk, sym, n);
+        for (uint8_t j = 0; j < n; j++) {
+            *(p++) = bech32_charset[sym[j]];
+        }
     }
 
-    if (!bech32_encode(out, hrp, tmp_data, tmp_size, enc)) {
+    chk = bech32_checksum_update(chk, zeros, sizeof(zeros)) ^ bech32_final_const(enc);
+    for (uint8_t i = 0; i < 6; i++) {
+        *(p++) = bech32_charset[(chk >> ((5u - i) * 5u)) & 0x1Fu];
+    }
+    *p = 0;
+
+    return zxerr_ok;
+}
+
+// Regroups the next (up to) five input bytes into 5-bit symbols and absorbs them into the checksum
+static void bech32_stream_refill(bech32_stream_t *ctx) {
+    const size_t chunk = (ctx->in_len - ctx->in_pos) < 5 ? (ctx->in_len - ctx->in_pos) : 5;
+    const uint8_t n = bech32_group_to_symbols(ctx->in + ctx->in_pos, chunk, ctx->pad, ctx->sym);
+    ctx->in_pos += chunk;
+
+    ctx->chk = bech32_checksum_update(ctx->chk, ctx->sym, n);
+    ctx->sym_len = n;
+    ctx->sym_pos = 0;
+}
+
+static char bech32_stream_next(bech32_stream_t *ctx) {
+    static const uint8_t zeros[6] = {0};
+    const size_t pos = ctx->pos++;
+
+    if (pos < ctx->hrp_len) {
+        return ctx->hrp[pos];
+    }
+    if (pos == ctx->hrp_len) {
+        return '1';
+    }
+    if (pos < ctx->data_end) {
+        if (ctx->sym_pos == ctx->sym_len) {
+            bech32_stream_refill(ctx);
+        }
+        return bech32_charset[ctx->sym[ctx->sym_pos++]];
+    }
+    if (pos == ctx->data_end) {
+        ctx->chk = bech32_checksum_update(ctx->chk, zeros, sizeof(zeros)) ^ bech32_final_const(ctx->enc);
+    }
+    return bech32_charset[(ctx->chk >> (5u * (5u - (pos - ctx->data_end)))) & 0x1Fu];
+}
+
+zxerr_t bech32_stream_init(bech32_stream_t *ctx, const char *hrp, const uint8_t *in, size_t in_len, uint8_t pad,
+                           bech32_encoding enc, size_t max_len) {
+    if (ctx == NULL) {
+        return zxerr_no_data;
+    }
+    if (enc != BECH32_ENCODING_BECH32 && enc != BECH32_ENCODING_BECH32M) {
         return zxerr_encoding_failed;
     }
+    MEMZERO(ctx, sizeof(*ctx));
+
+    size_t hrp_len = 0;
+    size_t symbols = 0;
+    CHECK_ZXERR(bech32_check_params(hrp, in, in_len, pad, max_len, &hrp_len, &symbols))
+
+    ctx->hrp = hrp;
+    ctx->in = in;
+    ctx->hrp_len = hrp_len;
+    ctx->in_len = in_len;
+    ctx->data_end = hrp_len + 1 + symbols;
+    ctx->total_len = ctx->data_end + 6;
+    ctx->chk = bech32_checksum_hrp(hrp, hrp_len);
+    ctx->pad = pad;
+    ctx->enc = enc;
+    return zxerr_ok;
+}
+
+zxerr_t bech32_stream_read(bech32_stream_t *ctx, char *out, size_t out_len, size_t *written) {
+    if (ctx == NULL || out == NULL || written == NULL) {
+        return zxerr_no_data;
+    }
+    if (out_len == 0) {
+        return zxerr_buffer_too_small;
+    }
 
+    size_t n = 0;
+    while (n + 1 < out_len && ctx->pos < ctx->total_len) {
+        out[n++] = bech32_stream_next(ctx);
+    }
+    out[n] = 0;
+    *written = n;
     return zxerr_ok;
 }
+
+zxerr_t bech32_stream_skip(bech32_stream_t *ctx, size_t count) {
+    if (ctx == NULL) {
+        return zxerr_no_data;
+    }
+    if (count > ctx->total_len - ctx->pos) {
+        return zxerr_out_of_bounds;
+    }
+    // hrp and separator can be jumped over; data symbols must still go through the checksum
+    if (ctx->pos <= ctx->hrp_len) {
+        const size_t jump = (ctx->hrp_len + 1 - ctx->pos) < count ? (ctx->hrp_len + 1 - ctx->pos) : count;
+        ctx->pos += jump;
+        count -= jump;
+    }
+    while (count-- > 0) {
+        bech32_stream_next(ctx);
+    }
+    return zxerr_ok;
+}
+
+zxerr_t bech32EncodeFromBytesPaged(char *outValue, uint16_t outValueLen, const char *hrp, const uint8_t *in,
+                                   size_t in_len, uint8_t pad, bech32_encoding enc, size_t max_len, uint8_t pageIdx,
+                                   uint8_t *pageCount) {
+    if (outValue == NULL || pageCount == NULL) {
+        return zxerr_no_data;
+    }
+    MEMZERO(outValue, outValueLen);
+    *pageCount = 0;
+    if (outValueLen < 2) {
+        return zxerr_buffer_too_small;
+    }
+
+    bech32_stream_t ctx;
+    CHECK_ZXERR(bech32_stream_init(&ctx, hrp, in, in_len, pad, enc, max_len))
+
+    const size_t chunk = outValueLen - 1;
+    const size_t pages = (ctx.total_len + chunk - 1) / chunk;
+    if (pages > UINT8_MAX) {
+        return zxerr_out_of_bounds;
+    }
+    *pageCount = (uint8_t)pages;
+    if (pageIdx >= *pageCount) {
+        return zxerr_ok;
+    }
+
+    size_t written = 0;
+    CHECK_ZXERR(bech32_stream_skip(&ctx, (size_t)pageIdx * chunk))
+    return bech32_stream_read(&ctx, outValue, outValueLen, &written);
+}
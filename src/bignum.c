@@ -15,6 +15,7 @@
  ********************************************************************************/
 #include "bignum.h"
 
+#include "zxfmt.h"
 #include "zxtypes.h"
 
 bool_t bignumLittleEndian_bcdprint(char *outBuffer, uint16_t outBufferLen, const uint8_t *inBCD, uint16_t inBCDLen) {
@@ -27,7 +28,7 @@ bool_t bignumLittleEndian_bcdprint(char *outBuffer, uint16_t outBufferLen, const
     }
 
     if (inBCDLen * 2 > outBufferLen) {
-        snprintf(outBuffer, outBufferLen, "ERR");
+        zx_fmt_copy(outBuffer, outBufferLen, "ERR");
         return bool_false;
     }
 
@@ -44,13 +45,168 @@ bool_t bignumLittleEndian_bcdprint(char *outBuffer, uint16_t outBufferLen, const
     }
 
     if (!started) {
-        snprintf(outBuffer, outBufferLen, "0");
+        zx_fmt_copy(outBuffer, outBufferLen, "0");
     }
 
     return bool_true;
 }
 
-void bignumLittleEndian_to_bcd(uint8_t *bcdOut, uint16_t bcdOutLen, const uint8_t *binValue, uint16_t binValueLen) {
+// Decimal conversion divides the value by a power of ten that fits in a limb and emits a whole chunk of digits
+// per pass over the limbs. Hosts with 128-bit arithmetic use 64-bit limbs and 10^19, everything else 32-bit
+// limbs and 10^9.
+#if defined(__SIZEOF_INT128__) && !defined(BIGNUM_DEC_RADIX_1E9)
+typedef uint64_t bignum_limb_t;
+typedef unsigned __int128 bignum_wide_t;
+#define BIGNUM_LIMB_BYTES 8u
+#define BIGNUM_CHUNK_BASE 10000000000000000000ull
+#else
+typedef uint32_t bignum_limb_t;
+typedef uint64_t bignum_wide_t;
+#define BIGNUM_LIMB_BYTES 4u
+#define BIGNUM_CHUNK_BASE 1000000000u
+#endif
+
+#define BIGNUM_DEC_MAX_LIMBS ((BIGNUM_DEC_MAX_INPUT_LEN + BIGNUM_LIMB_BYTES - 1) / BIGNUM_LIMB_BYTES)
+
+typedef struct {
+    // Most significant limb first, significant limbs are limbs[first..count)
+    bignum_limb_t limbs[BIGNUM_DEC_MAX_LIMBS];
+    uint16_t first;
+    uint16_t count;
+} bignum_dec_t;
+
+// Loads the value into limbs. Leading zero bytes are ignored; fails if the rest exceeds BIGNUM_DEC_MAX_INPUT_LEN
+static bool_t bignum_dec_load(bignum_dec_t *ctx, const uint8_t *binValue, uint16_t binValueLen, bool_t bigEndian) {
+    if (bigEndian) {
+        while (binValueLen > 0 && binValue[0] == 0) {
+            binValue++;
+            binValueLen--;
+        }
+    } else {
+        while (binValueLen > 0 && binValue[binValueLen - 1] == 0) {
+            binValueLen--;
+        }
+    }
+    if (binValueLen > BIGNUM_DEC_MAX_INPUT_LEN) {
+        return bool_false;
+    }
+
+    MEMZERO(ctx, sizeof(*ctx));
+    ctx->count = (uint16_t)((binValueLen + BIGNUM_LIMB_BYTES - 1) / BIGNUM_LIMB_BYTES);
+    for (uint16_t k = 0; k < binValueLen; k++) {
+        // k counts bytes from the least significant end
+        const uint8_t b = bigEndian ? binValue[binValueLen - 1 - k] : binValue[k];
+        ctx->limbs[ctx->count - 1 - k / BIGNUM_LIMB_BYTES] |= (bignum_limb_t)b << (8u * (k % BIGNUM_LIMB_BYTES));
+    }
+    return bool_true;
+}
+
+// Divides the value by BIGNUM_CHUNK_BASE and stores the digits of the remainder, least significant first.
+// Returns BIGNUM_DEC_CHUNK_DIGITS while higher digits remain, then only the significant digits of the last chunk
+// and 0 once the value is exhausted.
+static uint8_t bignum_dec_next(bignum_dec_t *ctx, uint8_t digits[BIGNUM_DEC_CHUNK_DIGITS]) {
+    if (ctx->first >= ctx->count) {
+        return 0;
+    }
+
+    bignum_wide_t rem = 0;
+    for (uint16_t i = ctx->first; i < ctx->count; i++) {
+        const bignum_wide_t cur = (rem << (8u * BIGNUM_LIMB_BYTES)) | ctx->limbs[i];
+        const bignum_limb_t q = (bignum_limb_t)(cur / BIGNUM_CHUNK_BASE);
+        rem = cur - (bignum_wide_t)q * BIGNUM_CHUNK_BASE;
+        ctx->limbs[i] = q;
+    }
+    while (ctx->first < ctx->count && ctx->limbs[ctx->first] == 0) {
+        ctx->first++;
+    }
+
+    bignum_limb_t r = (bignum_limb_t)rem;
+    uint8_t n = 0;
+    if (ctx->first < ctx->count) {
+        for (; n < BIGNUM_DEC_CHUNK_DIGITS; n++) {
+            digits[n] = (uint8_t)(r % 10u);
+            r /= 10u;
+        }
+    } else {
+        for (; r != 0; n++) {
+            digits[n] = (uint8_t)(r % 10u);
+            r /= 10u;
+        }
+    }
+    return n;
+}
+
+// Keeps the lowest 2 * bcdOutLen digits, as double-dabble does on overflow
+static void bignum_to_bcd(uint8_t *bcdOut, uint16_t bcdOutLen, bignum_dec_t *ctx, bool_t lsbFirst) {
+    MEMZERO(bcdOut, bcdOutLen);
+
+    const uint32_t maxDigits = 2u * (uint32_t)bcdOutLen;
+    uint32_t pos = 0;
+    uint8_t digits[BIGNUM_DEC_CHUNK_DIGITS];
+    uint8_t n = 0;
+    while (pos < maxDigits && (n = bignum_dec_next(ctx, digits)) > 0) {
+        for (uint8_t i = 0; i < n && pos < maxDigits; i++, pos++) {
+            const uint16_t idx = lsbFirst ? (uint16_t)(pos >> 1u) : (uint16_t)(bcdOutLen - 1 - (pos >> 1u));
+            bcdOut[idx] |= (uint8_t)(digits[i] << (4u * (pos & 1u)));
+        }
+    }
+}
+
+// Writes the value right to left at the end of outBuffer, inserting the decimal point and dropping trailing
+// fractional zeros as the digits come out, then moves the result to the front. Returns the length, 0 if it does
+// not fit.
+static uint16_t bignum_dec_format(char *outBuffer, uint16_t outBufferLen, bignum_dec_t *ctx, uint16_t decimals,
+                                  bool_t trim) {
+    if (outBufferLen == 0) {
+        return 0;
+    }
+
+    uint16_t pos = outBufferLen - 1;
+    outBuffer[pos] = 0;
+
+    // All fractional digits and the units digit are printed even when zero ("0", "0.05")
+    const uint32_t minDigits = (uint32_t)decimals + 1u;
+    bool_t trimming = (bool_t)(trim && decimals > 0);
+    uint8_t digits[BIGNUM_DEC_CHUNK_DIGITS];
+    uint8_t n = 0;
+    uint8_t i = 0;
+    for (uint32_t idx = 0;; idx++) {
+        if (i == n) {
+            n = bignum_dec_next(ctx, digits);
+            i = 0;
+        }
+
+        uint8_t d = 0;
+        if (i < n) {
+            d = digits[i++];
+        } else if (idx >= minDigits) {
+            break;
+        }
+
+        const uint16_t needed = (uint16_t)(1u + (decimals > 0 && idx == decimals));
+        if (pos < needed) {
+            MEMZERO(outBuffer, outBufferLen);
+            return 0;
+        }
+        if (needed > 1) {
+            outBuffer[--pos] = '.';
+        }
+        // Trimming keeps the first fractional digit
+        if (trimming && d == 0 && idx + 1 < decimals) {
+            continue;
+        }
+        trimming = bool_false;
+        outBuffer[--pos] = (char)('0' + d);
+    }
+
+    const uint16_t len = (uint16_t)(outBufferLen - 1 - pos);
+    memmove(outBuffer, outBuffer + pos, (size_t)len + 1);
+    return len;
+}
+
+// Bit-serial fallback for values longer than BIGNUM_DEC_MAX_INPUT_LEN
+static void bignumLittleEndian_doubleDabble(uint8_t *bcdOut, uint16_t bcdOutLen, const uint8_t *binValue,
+                                             uint16_t binValueLen) {
     MEMZERO(bcdOut, bcdOutLen);
 
     uint8_t carry = 0;
@@ -82,6 +238,39 @@ void bignumLittleEndian_to_bcd(uint8_t *bcdOut, uint16_t bcdOutLen, const uint8_
     }
 }
 
+static void bignumBigEndian_doubleDabble(uint8_t *bcdOut, uint16_t bcdOutLen, const uint8_t *binValue,
+                                          uint16_t binValueLen) {
+    MEMZERO(bcdOut, bcdOutLen);
+
+    uint8_t carry = 0;
+    for (uint32_t bitIdx = 0; bitIdx < binValueLen * 8; bitIdx++) {
+        // Fix bcd
+        for (uint16_t j = 0; j < bcdOutLen; j++) {
+            uint16_t tmp = bcdOut[j];
+            if ((bcdOut[j] & 0x0Fu) > 0x04u) {
+                tmp += 0x03u;
+            }
+            if ((bcdOut[j] & 0xF0u) > 0x40u) {
+                tmp += 0x30u;
+            }
+            bcdOut[j] = (uint8_t)tmp;
+        }
+
+        // get bit
+        const uint16_t byteIdx = bitIdx >> 3u;
+        const uint8_t mask = 0x80u >> (bitIdx & 0x7u);
+        carry = (uint8_t)((binValue[byteIdx] & mask) > 0);
+
+        // Shift bcd
+        for (uint16_t j = 0; j < bcdOutLen; j++) {
+            uint8_t carry2 = (uint8_t)(bcdOut[j] > 127u);
+            uint16_t temp = ((uint16_t)bcdOut[j] << 1u) + carry;
+            bcdOut[j] = (uint8_t)(temp & 0xFF);
+            carry = carry2;
+        }
+    }
+}
+
 bool_t bignumBigEndian_bcdprint(char *outBuffer, uint16_t outBufferLen, const uint8_t *bcdIn, uint16_t bcdInLen) {
     static const char hexchars[] = "0123456789ABCDEF";
     uint8_t started = 0;
@@ -92,7 +281,7 @@ bool_t bignumBigEndian_bcdprint(char *outBuffer, uint16_t outBufferLen, const ui
     }
 
     if (bcdInLen * 2 > outBufferLen) {
-        snprintf(outBuffer, outBufferLen, "ERR");
+        zx_fmt_copy(outBuffer, outBufferLen, "ERR");
         return bool_false;
     }
 
@@ -110,40 +299,56 @@ bool_t bignumBigEndian_bcdprint(char *outBuffer, uint16_t outBufferLen, const ui
     }
 
     if (!started) {
-        snprintf(outBuffer, outBufferLen, "0");
+        zx_fmt_copy(outBuffer, outBufferLen, "0");
     }
 
     return bool_true;
 }
 
+void bignumLittleEndian_to_bcd(uint8_t *bcdOut, uint16_t bcdOutLen, const uint8_t *binValue, uint16_t binValueLen) {
+    bignum_dec_t ctx;
+    if (!bignum_dec_load(&ctx, binValue, binValueLen, bool_false)) {
+        bignumLittleEndian_doubleDabble(bcdOut, bcdOutLen, binValue, binValueLen);
+        return;
+    }
+    bignum_to_bcd(bcdOut, bcdOutLen, &ctx, bool_false);
+}
+
 void bignumBigEndian_to_bcd(uint8_t *bcdOut, uint16_t bcdOutLen, const uint8_t *binValue, uint16_t binValueLen) {
-    MEMZERO(bcdOut, bcdOutLen);
+    bignum_dec_t ctx;
+    if (!bignum_dec_load(&ctx, binValue, binValueLen, bool_true)) {
+        bignumBigEndian_doubleDabble(bcdOut, bcdOutLen, binValue, binValueLen);
+        return;
+    }
+    bignum_to_bcd(bcdOut, bcdOutLen, &ctx, bool_true);
+}
 
-    uint8_t carry = 0;
-    for (uint32_t bitIdx = 0; bitIdx < binValueLen * 8; bitIdx++) {
-        // Fix bcd
-        for (uint16_t j = 0; j < bcdOutLen; j++) {
-            uint16_t tmp = bcdOut[j];
-            if ((bcdOut[j] & 0x0Fu) > 0x04u) {
-                tmp += 0x03u;
-            }
-            if ((bcdOut[j] & 0xF0u) > 0x40u) {
-                tmp += 0x30u;
-            }
-            bcdOut[j] = (uint8_t)tmp;
-        }
+bool_t bignumLittleEndian_to_decimal(char *outBuffer, uint16_t outBufferLen, const uint8_t *binValue,
+                                     uint16_t binValueLen) {
+    bignum_dec_t ctx;
+    if (!bignum_dec_load(&ctx, binValue, binValueLen, bool_false)) {
+        MEMZERO(outBuffer, outBufferLen);
+        return bool_false;
+    }
+    return (bool_t)(bignum_dec_format(outBuffer, outBufferLen, &ctx, 0, bool_false) > 0);
+}
 
-        // get bit
-        const uint16_t byteIdx = bitIdx >> 3u;
-        const uint8_t mask = 0x80u >> (bitIdx & 0x7u);
-        carry = (uint8_t)((binValue[byteIdx] & mask) > 0);
+bool_t bignumBigEndian_to_decimal(char *outBuffer, uint16_t outBufferLen, const uint8_t *binValue,
+                                  uint16_t binValueLen) {
+    bignum_dec_t ctx;
+    if (!bignum_dec_load(&ctx, binValue, binValueLen, bool_true)) {
+        MEMZERO(outBuffer, outBufferLen);
+        return bool_false;
+    }
+    return (bool_t)(bignum_dec_format(outBuffer, outBufferLen, &ctx, 0, bool_false) > 0);
+}
 
-        // Shift bcd
-        for (uint16_t j = 0; j < bcdOutLen; j++) {
-            uint8_t carry2 = (uint8_t)(bcdOut[j] > 127u);
-            uint16_t temp = ((uint16_t)bcdOut[j] << 1u) + carry;
-            bcdOut[j] = (uint8_t)(temp & 0xFF);
-            carry = carry2;
-        }
+uint16_t bignum_to_fpstr(char *out, uint16_t outLen, const uint8_t *bytes, uint16_t len, uint16_t decimals,
+                         bool_t trim) {
+    bignum_dec_t ctx;
+    if (!bignum_dec_load(&ctx, bytes, len, bool_true)) {
+        MEMZERO(out, outLen);
+        return 0;
     }
+    return bignum_dec_format(out, outLen, &ctx, decimals, trim);
 }
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include "cashaddr.h"
+
+#include "bch_checksum.h"
+
+BCH_CHECKSUM_DEFINE(cashaddr_polymod, uint64_t, BCH_CASHADDR_WIDTH, BCH_CASHADDR_T5)
+
+uint64_t cashaddr_checksum_update(uint64_t state, const uint8_t *symbols, size_t n) {
+    return cashaddr_polymod_update(state, symbols, n);
+}
+
+// Prefix is expanded to the low five bits of every char followed by a zero separator
+static uint64_t cashaddr_checksum_prefix(const char *prefix) {
+    uint64_t chk = 1;
+    size_t i = 0;
+    for (; prefix[i] != 0 && prefix[i + 1] != 0; i += 2) {
+        chk = cashaddr_polymod_step2(chk, (uint8_t)prefix[i] & 0x1Fu, (uint8_t)prefix[i + 1] & 0x1Fu);
+    }
+    if (prefix[i] != 0) {
+        return cashaddr_polymod_step2(chk, (uint8_t)prefix[i] & 0x1Fu, 0);
+    }
+    return cashaddr_polymod_step1(chk, 0);
+}
+
+static zxerr_t cashaddr_checksum_data(uint64_t *chk, const uint8_t *data, size_t dataLen) {
+    for (size_t i = 0; i < dataLen; i++) {
+        if (data[i] >> 5u) {
+            return zxerr_encoding_failed;
+        }
+    }
+    *chk = cashaddr_polymod_update(*chk, data, dataLen);
+    return zxerr_ok;
+}
+
+zxerr_t cashaddr_create_checksum(uint8_t *checksum, size_t checksumLen, const char *prefix, const uint8_t *data,
+                                 size_t dataLen) {
+    static const uint8_t zeros[CASHADDR_CHECKSUM_SYMBOLS] = {0};
+    if (checksum == NULL || prefix == NULL || (data == NULL && dataLen > 0)) {
+        return zxerr_no_data;
+    }
+    if (checksumLen < CASHADDR_CHECKSUM_SYMBOLS) {
+        return zxerr_buffer_too_small;
+    }
+
+    uint64_t chk = cashaddr_checksum_prefix(prefix);
+    const zxerr_t err = cashaddr_checksum_data(&chk, data, dataLen);
+    if (err != zxerr_ok) {
+        return err;
+    }
+    chk = cashaddr_polymod_update(chk, zeros, sizeof(zeros)) ^ CASHADDR_CONST;
+
+    for (size_t i = 0; i < CASHADDR_CHECKSUM_SYMBOLS; i++) {
+        checksum[i] = (uint8_t)((chk >> (5u * (CASHADDR_CHECKSUM_SYMBOLS - 1 - i))) & 0x1Fu);
+    }
+    return zxerr_ok;
+}
+
+zxerr_t cashaddr_verify_checksum(const char *prefix, const uint8_t *data, size_t dataLen) {
+    if (prefix == NULL || data == NULL) {
+        return zxerr_no_data;
+    }
+    if (dataLen < CASHADDR_CHECKSUM_SYMBOLS) {
+        return zxerr_out_of_bounds;
+    }
+
+    uint64_t chk = cashaddr_checksum_prefix(prefix);
+    const zxerr_t err = cashaddr_checksum_data(&chk, data, dataLen);
+    if (err != zxerr_ok) {
+        return err;
+    }
+    return chk == CASHADDR_CONST ? zxerr_ok : zxerr_encoding_failed;
+}
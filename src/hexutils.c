@@ -16,41 +16,81 @@
 
 #include "hexutils.h"
 
-#include <ctype.h>
 #include <string.h>
 
-uint8_t hex2dec(char c, char *out) {
-    c = (char)tolower((int)c);
+#define HEX_REP8(b) (0x0101010101010101ull * (uint64_t)(b))
+// Per-byte x >= lo and x > hi flags in bit 7, valid for bytes below 0x80
+#define HEX_GE(x, lo) ((x) + HEX_REP8(0x80u - (lo)))
+#define HEX_GT(x, hi) ((x) + HEX_REP8(0x7Fu - (hi)))
 
-    if (!isxdigit((int)c)) {
-        return 1;
+// Decodes 8 hex characters into 4 bytes; returns 0 if any of them is not a hex digit
+static uint8_t hex_decode8(uint8_t *out, const char *in) {
+    uint64_t x;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    x = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+        x |= (uint64_t)(uint8_t)in[i] << (8u * i);
     }
+#else
+    memcpy(&x, in, sizeof(x));
+#endif
+    const uint64_t high = x & HEX_REP8(0x80);
+    const uint64_t ascii = x & HEX_REP8(0x7F);
+    const uint64_t lower = ascii | HEX_REP8(0x20);
 
-    if (isdigit((int)c)) {
-        *out = (char)(c - '0');
+    const uint64_t digit = HEX_GE(ascii, '0') & ~HEX_GT(ascii, '9');
+    const uint64_t letter = HEX_GE(lower, 'a') & ~HEX_GT(lower, 'f');
+    // one mask for all eight characters
+    if (((digit | letter) & HEX_REP8(0x80)) != HEX_REP8(0x80) || high != 0) {
         return 0;
     }
 
-    *out = (char)(c - 'a' + 10);
-    return 0;
+    // '0'..'9' -> 0..9, 'a'..'f' / 'A'..'F' -> 1..6 + 9
+    uint64_t v = (ascii & HEX_REP8(0x0F)) + ((letter >> 7u) & HEX_REP8(0x01)) * 9u;
+    // byte 2k holds the high nibble of output byte k, byte 2k + 1 the low nibble
+    v = ((v & 0x00FF00FF00FF00FFull) << 4u) | ((v >> 8u) & 0x00FF00FF00FF00FFull);
+    v &= 0x00FF00FF00FF00FFull;
+    v = (v | (v >> 8u)) & 0x0000FFFF0000FFFFull;
+    v = (v | (v >> 16u)) & 0x00000000FFFFFFFFull;
+    for (uint8_t i = 0; i < 4; i++) {
+        out[i] = (uint8_t)(v >> (8u * i));
+    }
+    return 1;
 }
 
-size_t parseHexString(uint8_t *out, uint16_t outLen, const char *input) {
-    size_t len = strnlen(input, outLen * 2u + 1u);
-    if ((len / 2) > outLen) {
-        return 0;
-    }
-    if (len % 2 == 1) {
+// Branchless single-character decode; returns 0xFF for anything that is not a hex digit
+static uint8_t hex_nibble(char c) {
+    const uint8_t d = (uint8_t)((uint8_t)c - '0');
+    const uint8_t l = (uint8_t)(((uint8_t)c | 0x20u) - 'a');
+    const uint8_t isDigit = (uint8_t)-(uint8_t)(d < 10);
+    const uint8_t isLetter = (uint8_t)-(uint8_t)(l < 6);
+    return (uint8_t)((d & isDigit) | ((l + 10u) & isLetter) | (uint8_t)~(isDigit | isLetter));
+}
+
+size_t parseHexStringExt(uint8_t *out, size_t outLen, const char *input, size_t inputLen) {
+    if (out == NULL || input == NULL || inputLen % 2 == 1 || inputLen / 2 > outLen) {
         return 0;
     }
 
-    for (size_t i = 0; i < len; i += 2) {
-        char tmp1, tmp2;
-        if (hex2dec(input[i], &tmp1)) return 0;
-        if (hex2dec(input[i + 1], &tmp2)) return 0;
-
-        out[i >> 1u] = (tmp1 << 4u) + tmp2;
+    size_t i = 0;
+    for (; i + 8 <= inputLen; i += 8) {
+        if (!hex_decode8(out + i / 2, input + i)) {
+            return 0;
+        }
+    }
+    for (; i < inputLen; i += 2) {
+        const uint8_t hi = hex_nibble(input[i]);
+        const uint8_t lo = hex_nibble(input[i + 1]);
+        if ((hi | lo) == 0xFF) {
+            return 0;
+        }
+        out[i / 2] = (uint8_t)((hi << 4u) | lo);
     }
 
-    return (len / 2);
+    return inputLen / 2;
+}
+
+size_t parseHexString(uint8_t *out, uint16_t outLen, const char *input) {
+    size_t len = strnlen(input, outLen * 2u + 1u);
+    return parseHexStringExt(out, outLen, input, len);
 }
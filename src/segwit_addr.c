@@ -20,20 +20,43 @@
  */
 #include "segwit_addr.h"
 
+#include "bch_checksum.h"
+
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
-uint32_t bech32_polymod_step(uint32_t pre) {
-    uint8_t b = pre >> 25u;
-    return ((pre & 0x1FFFFFF) << 5) ^ ((uint32_t)-((b >> 0) & 1) & 0x3b6a57b2UL) ^
-           ((uint32_t)-((b >> 1) & 1) & 0x26508e6dUL) ^ ((uint32_t)-((b >> 2) & 1) & 0x1ea119faUL) ^
-           ((uint32_t)-((b >> 3) & 1) & 0x3d4233ddUL) ^ ((uint32_t)-((b >> 4) & 1) & 0x2a1462b3UL);
+BCH_CHECKSUM_DEFINE(bech32_polymod, uint32_t, BCH_BECH32_WIDTH, BCH_BECH32_T5)
+
+uint32_t bech32_polymod_step(uint32_t pre) { return bech32_polymod_step1(pre, 0); }
+
+uint32_t bech32_checksum_update(uint32_t state, const uint8_t *symbols, size_t n) {
+    return bech32_polymod_update(state, symbols, n);
+}
+
+uint32_t bech32_checksum_hrp(const char *hrp, size_t hrp_len) {
+    uint32_t chk = 1;
+    size_t i = 0;
+    for (; i + 1 < hrp_len; i += 2) {
+        chk = bech32_polymod_step2(chk, (uint8_t)hrp[i] >> 5u, (uint8_t)hrp[i + 1] >> 5u);
+    }
+    if (i < hrp_len) {
+        chk = bech32_polymod_step2(chk, (uint8_t)hrp[i] >> 5u, 0);
+    } else {
+        chk = bech32_polymod_step1(chk, 0);
+    }
+    for (i = 0; i + 1 < hrp_len; i += 2) {
+        chk = bech32_polymod_step2(chk, (uint8_t)hrp[i] & 0x1Fu, (uint8_t)hrp[i + 1] & 0x1Fu);
+    }
+    if (i < hrp_len) {
+        chk = bech32_polymod_step1(chk, (uint8_t)hrp[i] & 0x1Fu);
+    }
+    return chk;
 }
 
 static uint32_t bech32_final_constant(bech32_encoding enc) {
-    if (enc == BECH32_ENCODING_BECH32) return 1;
-    if (enc == BECH32_ENCODING_BECH32M) return 0x2bc830a3;
+    if (enc == BECH32_ENCODING_BECH32) return BECH32_CONST;
+    if (enc == BECH32_ENCODING_BECH32M) return BECH32M_CONST;
     return 0;
 }
 
@@ -47,34 +70,34 @@ static const int8_t charset_rev[128] = {
     23, -1, 18, 22, 31, 27, 19, -1, 1,  0,  3,  16, 11, 28, 12, 14, 6,  4,  2,  -1, -1, -1, -1, -1};
 
 int bech32_encode(char *output, const char *hrp, const uint8_t *data, size_t data_len, bech32_encoding enc) {
-    uint32_t chk = 1;
-    size_t i = 0;
-    while (hrp[i] != 0) {
-        char ch = hrp[i];
+    static const uint8_t zeros[6] = {0};
+    uint32_t chk;
+    size_t hrp_len = 0;
+    size_t i;
+    while (hrp[hrp_len] != 0) {
+        char ch = hrp[hrp_len];
         if (ch < 33 || ch > 126) {
             return 0;
         }
 
         if (ch >= 'A' && ch <= 'Z') return 0;
-        chk = bech32_polymod_step(chk) ^ (ch >> 5u);
-        ++i;
+        ++hrp_len;
     }
-    if (i + 7 + data_len > 90) return 0;
-    chk = bech32_polymod_step(chk);
-    while (*hrp != 0) {
-        chk = bech32_polymod_step(chk) ^ (*hrp & 0x1fu);
-        *(output++) = *(hrp++);
+    if (hrp_len + 7 + data_len > 90) return 0;
+    for (i = 0; i < data_len; ++i) {
+        if (data[i] >> 5u) return 0;
     }
+    chk = bech32_checksum_hrp(hrp, hrp_len);
+    chk = bech32_checksum_update(chk, data, data_len);
+    chk = bech32_checksum_update(chk, zeros, sizeof(zeros));
+    chk ^= bech32_final_constant(enc);
+
+    memcpy(output, hrp, hrp_len);
+    output += hrp_len;
     *(output++) = '1';
     for (i = 0; i < data_len; ++i) {
-        if (*data >> 5u) return 0;
-        chk = bech32_polymod_step(chk) ^ (*data);
-        *(output++) = charset[*(data++)];
+        *(output++) = charset[data[i]];
     }
-    for (i = 0; i < 6; ++i) {
-        chk = bech32_polymod_step(chk);
-    }
-    chk ^= bech32_final_constant(enc);
     for (i = 0; i < 6; ++i) {
         *(output++) = charset[(chk >> ((5u - i) * 5u)) & 0x1fu];
     }
@@ -83,11 +106,12 @@ int bech32_encode(char *output, const char *hrp, const uint8_t *data, size_t dat
 }
 
 bech32_encoding bech32_decode(char *hrp, uint8_t *data, size_t *data_len, const char *input) {
-    uint32_t chk = 1;
+    uint32_t chk;
     size_t i;
     size_t input_len = strlen(input);
     size_t hrp_len;
     int have_lower = 0, have_upper = 0;
+    int pending = -1;
     if (input_len < 8 || input_len > 90) {
         return 0;
     }
@@ -112,13 +136,9 @@ bech32_encoding bech32_decode(char *hrp, uint8_t *data, size_t *data_len, const
             ch = (ch - 'A') + 'a';
         }
         hrp[i] = ch;
-        chk = bech32_polymod_step(chk) ^ (ch >> 5u);
     }
     hrp[i] = 0;
-    chk = bech32_polymod_step(chk);
-    for (i = 0; i < hrp_len; ++i) {
-        chk = bech32_polymod_step(chk) ^ (input[i] & 0x1fu);
-    }
+    chk = bech32_checksum_hrp(hrp, hrp_len);
     ++i;
     while (i < input_len) {
         int v = (input[i] & 0x80u) ? -1 : charset_rev[(int)input[i]];
@@ -127,12 +147,21 @@ bech32_encoding bech32_decode(char *hrp, uint8_t *data, size_t *data_len, const
         if (v == -1) {
             return 0;
         }
-        chk = bech32_polymod_step(chk) ^ v;
+        // consume symbols in pairs so each table lookup reduces ten bits
+        if (pending < 0) {
+            pending = v;
+        } else {
+            chk = bech32_polymod_step2(chk, (uint8_t)pending, (uint8_t)v);
+            pending = -1;
+        }
         if (i + 6 < input_len) {
             data[i - (1 + hrp_len)] = v;
         }
         ++i;
     }
+    if (pending >= 0) {
+        chk = bech32_polymod_step1(chk, (uint8_t)pending);
+    }
     if (have_lower && have_upper) {
         return BECH32_ENCODING_NONE;
     }
@@ -189,20 +218,82 @@ int segwit_addr_encode(char *output, const char *hrp, int witver, const uint8_t
 }
 
 int segwit_addr_decode(int *witver, uint8_t *witdata, size_t *witdata_len, const char *hrp, const char *addr) {
-    uint8_t data[84];
-    char hrp_actual[84];
+    // Single pass over addr: the hrp is compared in place, and the 5-bit program symbols are
+    // regrouped into witdata while the checksum runs, so no copy of the input is needed.
+    const size_t input_len = strlen(addr);
+    size_t sep = input_len;
     size_t data_len;
-    bech32_encoding enc = bech32_decode(hrp_actual, data, &data_len, addr);
-    if (enc == BECH32_ENCODING_NONE) return 0;
+    size_t i;
+    int have_lower = 0, have_upper = 0;
+    if (input_len < 8 || input_len > 90) return 0;
+    while (sep > 0 && addr[sep - 1] != '1') --sep;
+    if (sep < 2 || input_len - sep < 6) return 0;
+    data_len = input_len - sep - 6;
     if (data_len == 0 || data_len > 65) return 0;
-    if (strncmp(hrp, hrp_actual, 84) != 0) return 0;
-    if (data[0] > 16) return 0;
-    if (data[0] == 0 && enc != BECH32_ENCODING_BECH32) return 0;
-    if (data[0] > 0 && enc != BECH32_ENCODING_BECH32M) return 0;
-    *witdata_len = 0;
-    if (!convert_bits(witdata, witdata_len, 8, data + 1, data_len - 1, 5, 0)) return 0;
+
+    const size_t hrp_len = sep - 1;
+    for (i = 0; i < hrp_len; ++i) {
+        char ch = addr[i];
+        if (ch < 33 || ch > 126) return 0;
+        if (ch >= 'a' && ch <= 'z') {
+            have_lower = 1;
+        } else if (ch >= 'A' && ch <= 'Z') {
+            have_upper = 1;
+            ch = (ch - 'A') + 'a';
+        }
+        if (ch != hrp[i]) return 0;
+    }
+    if (hrp[hrp_len] != 0) return 0;
+
+    uint32_t chk = bech32_checksum_hrp(hrp, hrp_len);
+    uint32_t acc = 0;
+    int bits = 0;
+    int pending = -1;
+    int version = 0;
+    size_t witlen = 0;
+    for (i = 0; i < data_len + 6; ++i) {
+        const char ch = addr[sep + i];
+        const int v = (ch & 0x80) ? -1 : charset_rev[(int)ch];
+        if (ch >= 'a' && ch <= 'z') have_lower = 1;
+        if (ch >= 'A' && ch <= 'Z') have_upper = 1;
+        if (v == -1) return 0;
+        if (pending < 0) {
+            pending = v;
+        } else {
+            chk = bech32_polymod_step2(chk, (uint8_t)pending, (uint8_t)v);
+            pending = -1;
+        }
+        if (i == 0) {
+            version = v;
+        } else if (i < data_len) {
+            acc = ((acc << 5u) | (uint32_t)v) & 0xFFFu;
+            bits += 5;
+            if (bits >= 8) {
+                bits -= 8;
+                witdata[witlen++] = (uint8_t)(acc >> bits);
+            }
+        }
+    }
+    if (pending >= 0) {
+        chk = bech32_polymod_step1(chk, (uint8_t)pending);
+    }
+    if (have_lower && have_upper) return 0;
+
+    bech32_encoding enc = BECH32_ENCODING_NONE;
+    if (chk == bech32_final_constant(BECH32_ENCODING_BECH32)) {
+        enc = BECH32_ENCODING_BECH32;
+    } else if (chk == bech32_final_constant(BECH32_ENCODING_BECH32M)) {
+        enc = BECH32_ENCODING_BECH32M;
+    }
+    if (enc == BECH32_ENCODING_NONE) return 0;
+    if (version > 16) return 0;
+    if (version == 0 && enc != BECH32_ENCODING_BECH32) return 0;
+    if (version > 0 && enc != BECH32_ENCODING_BECH32M) return 0;
+    // same padding rule as convert_bits without padding
+    if (bits >= 5 || (acc & ((1u << bits) - 1u)) != 0) return 0;
+    *witdata_len = witlen;
     if (*witdata_len < 2 || *witdata_len > 40) return 0;
-    if (data[0] == 0 && *witdata_len != 20 && *witdata_len != 32) return 0;
-    *witver = data[0];
+    if (version == 0 && *witdata_len != 20 && *witdata_len != 32) return 0;
+    *witver = version;
     return 1;
 }
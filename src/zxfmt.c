@@ -0,0 +1,352 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include "zxfmt.h"
+
+#include <string.h>
+
+// Decimal formatting. Digits are written right to left, two per division, into their final place:
+// the digit count is estimated from the bit length (log10(2) ~ 1233 / 4096) and corrected with one
+// comparison against a power of ten.
+static const char DEC_PAIRS[200] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static const uint64_t DEC_POW10[20] = {1ull,
+                                       10ull,
+                                       100ull,
+                                       1000ull,
+                                       10000ull,
+                                       100000ull,
+                                       1000000ull,
+                                       10000000ull,
+                                       100000000ull,
+                                       1000000000ull,
+                                       10000000000ull,
+                                       100000000000ull,
+                                       1000000000000ull,
+                                       10000000000000ull,
+                                       100000000000000ull,
+                                       1000000000000000ull,
+                                       10000000000000000ull,
+                                       100000000000000000ull,
+                                       1000000000000000000ull,
+                                       10000000000000000000ull};
+
+uint8_t zx_fmt_dec_len(uint64_t value) {
+    if (value == 0) {
+        return 1;
+    }
+    const uint32_t bits = 64u - (uint32_t)__builtin_clzll(value);
+    const uint8_t t = (uint8_t)((bits * 1233u) >> 12u);
+    return (uint8_t)(t + 1u - (value < DEC_POW10[t]));
+}
+
+// Writes value so that its last digit lands just before end
+static void dec_write32(char *end, uint32_t value) {
+    while (value >= 100u) {
+        const uint32_t r = value % 100u;
+        value /= 100u;
+        end -= 2;
+        MEMCPY(end, DEC_PAIRS + 2u * r, 2);
+    }
+    if (value >= 10u) {
+        MEMCPY(end - 2, DEC_PAIRS + 2u * value, 2);
+    } else {
+        *(end - 1) = (char)('0' + value);
+    }
+}
+
+void zx_fmt_dec_write(char *end, uint64_t value) {
+    // 64-bit divisions only while the value does not fit in 32 bits
+    while (value > UINT32_MAX) {
+        const uint64_t q = value / 100u;
+        const uint32_t r = (uint32_t)(value - q * 100u);
+        value = q;
+        end -= 2;
+        MEMCPY(end, DEC_PAIRS + 2u * r, 2);
+    }
+    dec_write32(end, (uint32_t)value);
+}
+
+void zx_fmt_dec_fixed(char *dst, uint32_t value, uint8_t width) {
+    char *end = dst + width;
+    while (end - dst >= 2) {
+        end -= 2;
+        MEMCPY(end, DEC_PAIRS + 2u * (value % 100u), 2);
+        value /= 100u;
+    }
+    if (end > dst) {
+        *dst = (char)('0' + value % 10u);
+    }
+}
+
+void zx_fmt_init(zx_fmt_t *f, char *buf, size_t size) {
+    f->buf = buf;
+    f->size = (uint16_t)(size > UINT16_MAX ? UINT16_MAX : size);
+    f->len = 0;
+    f->overflow = bool_false;
+    if (buf == NULL || f->size == 0) {
+        f->size = 0;
+        f->overflow = bool_true;
+        return;
+    }
+    buf[0] = 0;
+}
+
+// Appends n raw characters, truncating to the space left
+static void fmt_put(zx_fmt_t *f, const char *s, size_t n) {
+    if (f->size == 0) {
+        f->overflow = bool_true;
+        return;
+    }
+    const size_t room = (size_t)(f->size - 1 - f->len);
+    if (n > room) {
+        n = room;
+        f->overflow = bool_true;
+    }
+    MEMCPY(f->buf + f->len, s, n);
+    f->len = (uint16_t)(f->len + n);
+    f->buf[f->len] = 0;
+}
+
+void zx_fmt_str(zx_fmt_t *f, const char *s) {
+    if (s != NULL) {
+        fmt_put(f, s, strlen(s));
+    }
+}
+
+void zx_fmt_strn(zx_fmt_t *f, const char *s, size_t n) {
+    if (s != NULL) {
+        fmt_put(f, s, strnlen(s, n));
+    }
+}
+
+void zx_fmt_char(zx_fmt_t *f, char c) { fmt_put(f, &c, 1); }
+
+void zx_fmt_repeat(zx_fmt_t *f, char c, uint16_t count) {
+    if (f->size == 0) {
+        f->overflow = bool_true;
+        return;
+    }
+    const uint16_t room = (uint16_t)(f->size - 1 - f->len);
+    if (count > room) {
+        count = room;
+        f->overflow = bool_true;
+    }
+    MEMSET(f->buf + f->len, c, count);
+    f->len = (uint16_t)(f->len + count);
+    f->buf[f->len] = 0;
+}
+
+void zx_fmt_u64(zx_fmt_t *f, uint64_t value, uint8_t width) {
+    const uint8_t digits = zx_fmt_dec_len(value);
+    if (width > digits) {
+        zx_fmt_repeat(f, '0', (uint16_t)(width - digits));
+    }
+    char tmp[20];
+    zx_fmt_dec_write(tmp + digits, value);
+    fmt_put(f, tmp, digits);
+}
+
+void zx_fmt_i64(zx_fmt_t *f, int64_t value) {
+    if (value < 0) {
+        zx_fmt_char(f, '-');
+        // Negate in unsigned arithmetic so INT64_MIN does not overflow
+        zx_fmt_u64(f, (uint64_t)0 - (uint64_t)value, 0);
+        return;
+    }
+    zx_fmt_u64(f, (uint64_t)value, 0);
+}
+
+void zx_fmt_hex(zx_fmt_t *f, uint64_t value, uint8_t width, bool_t uppercase) {
+    const char *hexchars = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+    char tmp[16];
+    uint8_t digits = 0;
+    do {
+        tmp[sizeof(tmp) - 1 - digits] = hexchars[value & 0x0Fu];
+        value >>= 4u;
+        digits++;
+    } while (value != 0);
+
+    if (width > digits) {
+        zx_fmt_repeat(f, '0', (uint16_t)(width - digits));
+    }
+    fmt_put(f, tmp + sizeof(tmp) - digits, digits);
+}
+
+void zx_fmt_fixed(zx_fmt_t *f, uint64_t value, uint8_t decimals) {
+    const uint8_t digits = zx_fmt_dec_len(value);
+    char tmp[20];
+    zx_fmt_dec_write(tmp + digits, value);
+
+    if (decimals == 0) {
+        fmt_put(f, tmp, digits);
+        return;
+    }
+
+    if (digits <= decimals) {
+        fmt_put(f, "0.", 2);
+        zx_fmt_repeat(f, '0', (uint16_t)(decimals - digits));
+        fmt_put(f, tmp, digits);
+        return;
+    }
+
+    fmt_put(f, tmp, (size_t)(digits - decimals));
+    zx_fmt_char(f, '.');
+    fmt_put(f, tmp + digits - decimals, decimals);
+}
+
+uint16_t zx_fmt_copy(char *dst, size_t dstSize, const char *src) {
+    zx_fmt_t f;
+    zx_fmt_init(&f, dst, dstSize);
+    zx_fmt_str(&f, src);
+    return f.len;
+}
+
+zxerr_t zx_strbuf_init(zx_strbuf_t *sb, char *buf, size_t size, uint16_t headroom) {
+    if (sb == NULL || buf == NULL || size == 0) {
+        return zxerr_buffer_too_small;
+    }
+    sb->buf = buf;
+    sb->size = (uint16_t)(size > UINT16_MAX ? UINT16_MAX : size);
+    if (headroom >= sb->size) {
+        return zxerr_buffer_too_small;
+    }
+    sb->start = headroom;
+    sb->len = 0;
+    buf[headroom] = 0;
+    return zxerr_ok;
+}
+
+zxerr_t zx_strbuf_wrap(zx_strbuf_t *sb, char *buf, size_t size) {
+    if (sb == NULL || buf == NULL || size == 0) {
+        return zxerr_buffer_too_small;
+    }
+    sb->buf = buf;
+    sb->size = (uint16_t)(size > UINT16_MAX ? UINT16_MAX : size);
+    sb->start = 0;
+    sb->len = (uint16_t)strnlen(buf, sb->size);
+    if (sb->len == sb->size) {
+        // Not terminated within the buffer
+        return zxerr_buffer_too_small;
+    }
+    return zxerr_ok;
+}
+
+zxerr_t zx_strbuf_append(zx_strbuf_t *sb, const char *s, size_t n) {
+    if (n == 0) {
+        return zxerr_ok;
+    }
+    if (n > (size_t)(sb->size - 1 - sb->start - sb->len)) {
+        return zxerr_buffer_too_small;
+    }
+    char *end = sb->buf + sb->start + sb->len;
+    MEMCPY(end, s, n);
+    end[n] = 0;
+    sb->len = (uint16_t)(sb->len + n);
+    return zxerr_ok;
+}
+
+zxerr_t zx_strbuf_append_str(zx_strbuf_t *sb, const char *s) {
+    if (s == NULL) {
+        return zxerr_ok;
+    }
+    return zx_strbuf_append(sb, s, strlen(s));
+}
+
+// Makes room for n characters in front of the content, moving it only if the headroom is short
+static zxerr_t strbuf_reserve_front(zx_strbuf_t *sb, size_t n) {
+    if (n <= sb->start) {
+        sb->start = (uint16_t)(sb->start - n);
+        sb->len = (uint16_t)(sb->len + n);
+        return zxerr_ok;
+    }
+    if (n > (size_t)(sb->size - 1 - sb->len)) {
+        return zxerr_buffer_too_small;
+    }
+    MEMMOVE(sb->buf + n, sb->buf + sb->start, (size_t)sb->len + 1);
+    sb->start = 0;
+    sb->len = (uint16_t)(sb->len + n);
+    return zxerr_ok;
+}
+
+zxerr_t zx_strbuf_prepend(zx_strbuf_t *sb, const char *s, size_t n) {
+    if (n == 0) {
+        return zxerr_ok;
+    }
+    CHECK_ZXERR(strbuf_reserve_front(sb, n))
+    MEMCPY(sb->buf + sb->start, s, n);
+    return zxerr_ok;
+}
+
+zxerr_t zx_strbuf_pad_left(zx_strbuf_t *sb, char c, uint16_t width) {
+    if (sb->len >= width) {
+        return zxerr_ok;
+    }
+    const uint16_t n = (uint16_t)(width - sb->len);
+    CHECK_ZXERR(strbuf_reserve_front(sb, n))
+    MEMSET(sb->buf + sb->start, c, n);
+    return zxerr_ok;
+}
+
+zxerr_t zx_strbuf_insert_char(zx_strbuf_t *sb, uint16_t pos, char c) {
+    if (pos > sb->len) {
+        return zxerr_out_of_bounds;
+    }
+    const bool_t roomRight = (bool_t)(sb->start + sb->len + 1u < sb->size);
+    if (sb->start > 0 && (pos < sb->len - pos || !roomRight)) {
+        // Shift the head one position into the headroom
+        MEMMOVE(sb->buf + sb->start - 1, sb->buf + sb->start, pos);
+        sb->start--;
+    } else if (roomRight) {
+        char *p = sb->buf + sb->start + pos;
+        MEMMOVE(p + 1, p, (size_t)(sb->len - pos) + 1);
+    } else {
+        return zxerr_buffer_too_small;
+    }
+    sb->buf[sb->start + pos] = c;
+    sb->len++;
+    return zxerr_ok;
+}
+
+zxerr_t zx_strbuf_remove_prefix(zx_strbuf_t *sb, uint16_t n) {
+    if (n > sb->len) {
+        return zxerr_out_of_bounds;
+    }
+    sb->start = (uint16_t)(sb->start + n);
+    sb->len = (uint16_t)(sb->len - n);
+    return zxerr_ok;
+}
+
+zxerr_t zx_strbuf_truncate(zx_strbuf_t *sb, uint16_t len) {
+    if (len > sb->len) {
+        return zxerr_out_of_bounds;
+    }
+    sb->len = len;
+    sb->buf[sb->start + len] = 0;
+    return zxerr_ok;
+}
+
+uint16_t zx_strbuf_finish(zx_strbuf_t *sb) {
+    if (sb->start > 0) {
+        MEMMOVE(sb->buf, sb->buf + sb->start, (size_t)sb->len + 1);
+        sb->start = 0;
+    }
+    return sb->len;
+}
@@ -18,102 +18,159 @@
 #include <string.h>
 #include <zxerror.h>
 
-#include "utf8.h"
+#include "zxfmt.h"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 size_t asciify(char *utf8_in_ascii_out) { return asciify_ext(utf8_in_ascii_out, utf8_in_ascii_out); }
 
 size_t asciify_ext(const char *utf8_in, char *ascii_only_out) {
-    void *p = (void *)utf8_in;
+    return asciify_ext_n(utf8_in, strlen(utf8_in), ascii_only_out);
+}
+
+#define ASCII_WORD_HIGH_BITS 0x8080808080808080ull
+#define ASCII_WORD_SPACES 0x2020202020202020ull
+
+// Length of the UTF-8 sequence at in, or 0 if it is malformed, truncated or overlong. Like utf8valid,
+// leads up to 0xF7 are accepted and surrogates are not rejected.
+static size_t utf8_sequence_len(const uint8_t *in, size_t remaining) {
+    const uint8_t c = in[0];
+    size_t len = 0;
+    if ((c & 0xE0u) == 0xC0u) {
+        len = (c & 0x1Eu) != 0 ? 2 : 0;
+    } else if ((c & 0xF0u) == 0xE0u) {
+        len = (remaining >= 2 && ((c & 0x0Fu) != 0 || (in[1] & 0x20u) != 0)) ? 3 : 0;
+    } else if ((c & 0xF8u) == 0xF0u) {
+        len = (remaining >= 2 && ((c & 0x07u) != 0 || (in[1] & 0x30u) != 0)) ? 4 : 0;
+    }
+    if (len == 0 || len > remaining) {
+        return 0;
+    }
+    for (size_t i = 1; i < len; i++) {
+        if ((in[i] & 0xC0u) != 0x80u) {
+            return 0;
+        }
+    }
+    return len;
+}
+
+size_t asciify_ext_n(const char *utf8_in, size_t len, char *ascii_only_out) {
+    const uint8_t *in = (const uint8_t *)utf8_in;
     char *q = ascii_only_out;
+    size_t i = 0;
+
+    while (i < len) {
+        // Eight ASCII bytes at a time; they are copied as is unless one of them is a control character
+        if (i + 8 <= len) {
+            uint64_t w;
+            MEMCPY(&w, in + i, sizeof(w));
+            if ((w & ASCII_WORD_HIGH_BITS) == 0) {
+                if (((w - ASCII_WORD_SPACES) & ASCII_WORD_HIGH_BITS) == 0) {
+                    MEMCPY(q, &w, sizeof(w));
+                } else {
+                    for (uint8_t j = 0; j < 8; j++) {
+                        q[j] = in[i + j] < 32 ? '.' : (char)in[i + j];
+                    }
+                }
+                q += 8;
+                i += 8;
+                continue;
+            }
+        }
 
-    // utf8valid returns zero on success
-    while (*((char *)p) && utf8valid(p) == 0) {
-        utf8_int32_t tmp_codepoint = 0;
-        p = utf8codepoint(p, &tmp_codepoint);
-        *q = (char)((tmp_codepoint >= 32 && tmp_codepoint <= (int32_t)0x7F) ? tmp_codepoint : '.');
-        q++;
+        if (in[i] < 0x80u) {
+            *q++ = in[i] < 32 ? '.' : (char)in[i];
+            i++;
+            continue;
+        }
+
+        // Anything above 0x7F is not printable ASCII
+        const size_t seqLen = utf8_sequence_len(in + i, len - i);
+        if (seqLen == 0) {
+            ascii_only_out[0] = 0;
+            return 0;
+        }
+        *q++ = '.';
+        i += seqLen;
     }
 
     // Terminate string
     *q = 0;
-    return q - ascii_only_out;
+    return (size_t)(q - ascii_only_out);
 }
 
-uint8_t intstr_to_fpstr_inplace(char *number, size_t number_max_size, uint8_t decimalPlaces) {
-    size_t numChars = strnlen(number, number_max_size);
-    MEMZERO(number + numChars, number_max_size - numChars);
-
-    if (number_max_size < 1) {
-        // No space to do anything
-        return 0;
-    }
-
-    if (number_max_size <= numChars) {
-        // No space to do anything
-        return 0;
+zxerr_t intstr_to_fpstr_sb(zx_strbuf_t *sb, uint16_t decimalPlaces) {
+    if (sb == NULL || decimalPlaces == UINT16_MAX) {
+        return zxerr_buffer_too_small;
     }
 
-    if (numChars == 0) {
+    if (sb->len == 0) {
         // Empty number, make a zero
-        snprintf(number, number_max_size, "0");
-        numChars = 1;
+        CHECK_ZXERR(zx_strbuf_append(sb, "0", 1))
     }
 
     // Check all are numbers
-    size_t firstDigit = numChars;
-    for (size_t i = 0; i < numChars; i++) {
+    const char *number = zx_strbuf_cstr(sb);
+    uint16_t firstDigit = sb->len;
+    for (uint16_t i = 0; i < sb->len; i++) {
         if (number[i] < '0' || number[i] > '9') {
-            snprintf(number, number_max_size, "ERR");
-            return 0;
+            return zxerr_encoding_failed;
         }
-        if (number[i] != '0' && firstDigit > i) {
+        if (number[i] != '0' && firstDigit == sb->len) {
             firstDigit = i;
         }
     }
 
-    // Trim any incorrect leading zeros
-    if (firstDigit == numChars) {
-        snprintf(number, number_max_size, "0");
-        numChars = 1;
-    } else {
-        // Trim leading zeros
-        MEMMOVE(number, number + firstDigit, numChars - firstDigit);
-        MEMZERO(number + numChars - firstDigit, firstDigit);
-    }
+    // Trim leading zeros, keeping one for a zero value
+    CHECK_ZXERR(zx_strbuf_remove_prefix(sb, firstDigit == sb->len ? (uint16_t)(sb->len - 1) : firstDigit))
 
     // If there are no decimal places return
     if (decimalPlaces == 0) {
-        return numChars;
+        return zxerr_ok;
     }
 
-    // Now insert decimal point
-
-    //        0123456789012     <-decimal places
-    //        abcd              < numChars = 4
-    //                 abcd     < shift
-    //        000000000abcd     < fill
+    //        abcd              < len = 4
+    //        000000000abcd     < pad to decimalPlaces + 1
     //        0.00000000abcd    < add decimal point
-    const uint16_t tmpDecimalPlaces = decimalPlaces;
-    if (numChars < tmpDecimalPlaces + 1) {
-        // Move to end
-        const uint16_t padSize = tmpDecimalPlaces - numChars + 1;
-        MEMMOVE(number + padSize, number, numChars);
-        MEMSET(number, '0', padSize);
-        numChars = strnlen(number, number_max_size);
+    CHECK_ZXERR(zx_strbuf_pad_left(sb, '0', (uint16_t)(decimalPlaces + 1)))
+    return zx_strbuf_insert_char(sb, (uint16_t)(sb->len - decimalPlaces), '.');
+}
+
+void number_trimming_sb(zx_strbuf_t *sb, uint8_t non_trimmed) {
+    const char *s = zx_strbuf_cstr(sb);
+    const char *point = memchr(s, '.', sb->len);
+    if (point == NULL) {
+        return;
     }
 
-    if (numChars < decimalPlaces) {
+    const uint16_t limit = (uint16_t)(point - s) + non_trimmed + 1;
+    uint16_t len = sb->len;
+    while (len > limit && s[len - 1] == '0') {
+        len--;
+    }
+    zx_strbuf_truncate(sb, len);
+}
+
+uint8_t intstr_to_fpstr_inplace(char *number, size_t number_max_size, uint8_t decimalPlaces) {
+    zx_strbuf_t sb;
+    if (zx_strbuf_wrap(&sb, number, number_max_size) != zxerr_ok) {
+        // No space to do anything
         return 0;
     }
-    // add decimal point
-    const uint16_t pointPosition = numChars - decimalPlaces;
-    MEMMOVE(number + pointPosition + 1, number + pointPosition, decimalPlaces);  // shift content
-    number[pointPosition] = '.';
 
-    numChars = strnlen(number, number_max_size);
+    const zxerr_t err = intstr_to_fpstr_sb(&sb, decimalPlaces);
+    const uint16_t numChars = zx_strbuf_finish(&sb);
+    MEMZERO(number + numChars, sb.size - numChars);
 
-    if (numChars > UINT8_MAX) {
-        // Overflow
+    if (err == zxerr_encoding_failed) {
+        zx_fmt_copy(number, number_max_size, "ERR");
+        return 0;
+    }
+    if (err != zxerr_ok || numChars > UINT8_MAX) {
         return 0;
     }
     return (uint8_t)numChars;
@@ -124,97 +181,436 @@ zxerr_t insertDecimalPoint(char *output, uint16_t outputLen, uint16_t decimalPla
         return zxerr_buffer_too_small;
     }
 
-    uint16_t numChars = strnlen(output, outputLen);
+    zx_strbuf_t sb;
+    CHECK_ZXERR(zx_strbuf_wrap(&sb, output, outputLen))
+
+    const zxerr_t err = intstr_to_fpstr_sb(&sb, decimalPlaces);
+    const uint16_t numChars = zx_strbuf_finish(&sb);
     MEMZERO(output + numChars, outputLen - numChars);
 
-    if (outputLen <= numChars) {
-        // No space to do anything
+    if (err == zxerr_encoding_failed) {
+        zx_fmt_copy(output, outputLen, "ERR");
+    }
+    return err;
+}
+
+size_t z_strlen(const char *buffer, size_t maxSize) {
+    if (buffer == NULL) return 0;
+    return strnlen(buffer, maxSize);
+}
+
+zxerr_t z_str3join(char *buffer, size_t bufferSize, const char *prefix, const char *suffix) {
+    zx_strbuf_t sb;
+    if (zx_strbuf_wrap(&sb, buffer, bufferSize) != zxerr_ok ||
+        zx_strbuf_append(&sb, suffix, z_strlen(suffix, bufferSize)) != zxerr_ok ||
+        zx_strbuf_prepend(&sb, prefix, z_strlen(prefix, bufferSize)) != zxerr_ok) {
+        zx_fmt_copy(buffer, bufferSize, "ERR???");
         return zxerr_buffer_too_small;
     }
+    return zxerr_ok;
+}
 
-    if (numChars == 0) {
-        // Empty number, make a zero
-        snprintf(output, outputLen, "0");
-        numChars = 1;
+uint16_t uint64_to_str_len(char *data, uint16_t dataLen, uint64_t number) {
+    if (data == NULL) {
+        return 0;
     }
+    const uint8_t digits = zx_fmt_dec_len(number);
+    if (dataLen <= digits) {
+        MEMZERO(data, dataLen);
+        return 0;
+    }
+    data[digits] = 0;
+    zx_fmt_dec_write(data + digits, number);
+    return digits;
+}
 
-    // Check all are numbers
-    uint16_t firstDigit = numChars;
-    for (size_t i = 0; i < numChars; i++) {
-        if (output[i] < '0' || output[i] > '9') {
-            snprintf(output, outputLen, "ERR");
-            return zxerr_encoding_failed;
+uint16_t uint32_to_str_len(char *data, uint16_t dataLen, uint32_t number) {
+    if (data == NULL) {
+        return 0;
+    }
+    const uint8_t digits = zx_fmt_dec_len(number);
+    if (dataLen <= digits) {
+        MEMZERO(data, dataLen);
+        return 0;
+    }
+    data[digits] = 0;
+    zx_fmt_dec_write(data + digits, number);
+    return digits;
+}
+
+uint16_t int64_to_str_len(char *data, uint16_t dataLen, int64_t number) {
+    if (number >= 0) {
+        return uint64_to_str_len(data, dataLen, (uint64_t)number);
+    }
+    if (data == NULL) {
+        return 0;
+    }
+    if (dataLen < 2) {
+        MEMZERO(data, dataLen);
+        return 0;
+    }
+    // Negate in unsigned arithmetic so INT64_MIN does not overflow
+    const uint16_t len = uint64_to_str_len(data + 1, dataLen - 1, (uint64_t)0 - (uint64_t)number);
+    if (len == 0) {
+        data[0] = 0;
+        return 0;
+    }
+    data[0] = '-';
+    return len + 1;
+}
+
+uint16_t int32_to_str_len(char *data, uint16_t dataLen, int32_t number) {
+    if (number >= 0) {
+        return uint32_to_str_len(data, dataLen, (uint32_t)number);
+    }
+    if (data == NULL) {
+        return 0;
+    }
+    if (dataLen < 2) {
+        MEMZERO(data, dataLen);
+        return 0;
+    }
+    const uint16_t len = uint32_to_str_len(data + 1, dataLen - 1, (uint32_t)0 - (uint32_t)number);
+    if (len == 0) {
+        data[0] = 0;
+        return 0;
+    }
+    data[0] = '-';
+    return len + 1;
+}
+
+uint16_t bip32_to_str_len(char *s, uint16_t max, const uint32_t *path, uint8_t pathLen) {
+    if (s == NULL || max == 0) {
+        return 0;
+    }
+
+    if (pathLen == 0) {
+        static const char empty[] = "EMPTY PATH";
+        if (max < sizeof(empty)) {
+            MEMZERO(s, max);
+            return 0;
         }
-        if (output[i] != '0' && firstDigit > i) {
-            firstDigit = i;
+        MEMCPY(s, empty, sizeof(empty));
+        return sizeof(empty) - 1;
+    }
+
+    if (path == NULL) {
+        MEMZERO(s, max);
+        return 0;
+    }
+
+    uint16_t offset = 0;
+    for (uint16_t i = 0; i < pathLen; i++) {
+        const uint32_t index = path[i] & 0x7FFFFFFFu;
+        const uint8_t digits = zx_fmt_dec_len(index);
+        const uint8_t hardened = (uint8_t)((path[i] & 0x80000000u) != 0);
+        const uint8_t separator = (uint8_t)(i + 1 < pathLen);
+
+        // Keep room for the terminator
+        if ((uint32_t)offset + digits + hardened + separator >= max) {
+            MEMZERO(s, max);
+            return 0;
+        }
+
+        offset += digits;
+        zx_fmt_dec_write(s + offset, index);
+        if (hardened) {
+            s[offset++] = '\'';
+        }
+        if (separator) {
+            s[offset++] = '/';
         }
     }
+    s[offset] = 0;
+    return offset;
+}
 
-    // Trim any incorrect leading zeros
-    if (firstDigit == numChars) {
-        snprintf(output, outputLen, "0");
-        numChars = 1;
-    } else {
-        // Trim leading zeros
-        MEMMOVE(output, output + firstDigit, numChars - firstDigit);
-        MEMZERO(output + numChars - firstDigit, firstDigit);
+// Hex encoding. The bulk of the input goes through SSSE3/NEON on host builds that have them,
+// otherwise through a word-at-a-time (SWAR) path. The remainder uses a 512-byte two-character
+// table per case, or the 16-character nibble table when ZXFORMAT_HEX_COMPACT is defined.
+#if defined(ZXFORMAT_HEX_COMPACT) || defined(__SSSE3__) || (defined(__ARM_NEON) && defined(__aarch64__))
+#define HEX_USE_DIGITS
+static const char HEX_DIGITS_LOWER[] = "0123456789abcdef";
+static const char HEX_DIGITS_UPPER[] = "0123456789ABCDEF";
+#endif
+
+#if !defined(ZXFORMAT_HEX_COMPACT)
+static const char HEX_PAIRS_LOWER[] =
+    "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+    "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+    "404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+    "606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+    "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+    "a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+    "c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+    "e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+static const char HEX_PAIRS_UPPER[] =
+    "000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F"
+    "202122232425262728292A2B2C2D2E2F303132333435363738393A3B3C3D3E3F"
+    "404142434445464748494A4B4C4D4E4F505152535455565758595A5B5C5D5E5F"
+    "606162636465666768696A6B6C6D6E6F707172737475767778797A7B7C7D7E7F"
+    "808182838485868788898A8B8C8D8E8F909192939495969798999A9B9C9D9E9F"
+    "A0A1A2A3A4A5A6A7A8A9AAABACADAEAFB0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+    "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECFD0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+    "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEFF0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+#endif
+
+#if UINTPTR_MAX > 0xFFFFFFFFu
+typedef uint64_t hex_word_t;
+#else
+typedef uint32_t hex_word_t;
+#endif
+#define HEX_WORD_BYTES (sizeof(hex_word_t) / 2)
+#define HEX_REP8(b) ((hex_word_t)-1 / 0xFFu * (hex_word_t)(b))
+#define HEX_REP16(h) ((hex_word_t)-1 / 0xFFFFu * (hex_word_t)(h))
+
+// Encodes HEX_WORD_BYTES input bytes into 2 * HEX_WORD_BYTES characters; alpha is the
+// distance from '9' + 1 to the first letter
+__Z_INLINE void hex_encode_word(char *dst, const uint8_t *src, hex_word_t alpha) {
+    // spread byte i to 16-bit lane i
+#if UINTPTR_MAX > 0xFFFFFFFFu
+    hex_word_t y = (hex_word_t)src[0] | ((hex_word_t)src[1] << 16u) | ((hex_word_t)src[2] << 32u) |
+                   ((hex_word_t)src[3] << 48u);
+#else
+    hex_word_t y = (hex_word_t)src[0] | ((hex_word_t)src[1] << 16u);
+#endif
+    // lane bytes: high nibble first, low nibble second
+    const hex_word_t n = ((y >> 4u) & HEX_REP16(0x000F)) | ((y & HEX_REP16(0x000F)) << 8u);
+    // nibbles above 9 carry into bit 4 when 6 is added; those get the letter offset
+    const hex_word_t letters = ((n + HEX_REP8(0x06)) >> 4u) & HEX_REP8(0x01);
+    const hex_word_t c = n + HEX_REP8('0') + letters * alpha;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    for (size_t i = 0; i < sizeof(hex_word_t); i++) {
+        dst[i] = (char)(c >> (8u * i));
     }
+#else
+    MEMCPY(dst, &c, sizeof(c));
+#endif
+}
 
-    // If there are no decimal places return
-    if (decimalPlaces == 0) {
-        return zxerr_ok;
+void array_to_hexchars(char *dst, const uint8_t *src, size_t count, bool uppercase) {
+    size_t i = 0;
+#if defined(HEX_USE_DIGITS)
+    const char *digits = uppercase ? HEX_DIGITS_UPPER : HEX_DIGITS_LOWER;
+#endif
+
+#if defined(__SSSE3__)
+    const __m128i table = _mm_loadu_si128((const __m128i *)digits);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    for (; i + 16 <= count; i += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        const __m128i hi = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+        const __m128i lo = _mm_shuffle_epi8(table, _mm_and_si128(v, nibble));
+        _mm_storeu_si128((__m128i *)(dst + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i *)(dst + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint8x16_t table = vld1q_u8((const uint8_t *)digits);
+    for (; i + 16 <= count; i += 16) {
+        const uint8x16_t v = vld1q_u8(src + i);
+        uint8x16x2_t out;
+        out.val[0] = vqtbl1q_u8(table, vshrq_n_u8(v, 4));
+        out.val[1] = vqtbl1q_u8(table, vandq_u8(v, vdupq_n_u8(0x0F)));
+        vst2q_u8((uint8_t *)(dst + 2 * i), out);
     }
+#endif
 
-    // Now insert decimal point
-    // 0123456789012     <-decimal places
-    //          abcd     < numChars = 4
-    //          abcd     < shift
-    // 000000000abcd     < fill
-    // 0.00000000abcd    < add decimal point
-    if (numChars < decimalPlaces + 1) {
-        // Move to end
-        const uint16_t padSize = decimalPlaces - numChars + 1;
-        MEMMOVE(output + padSize, output, numChars);
-        MEMSET(output, '0', padSize);
-        numChars = strnlen(output, outputLen);
+    const hex_word_t alpha = uppercase ? 'A' - '9' - 1 : 'a' - '9' - 1;
+    for (; i + 2 * HEX_WORD_BYTES <= count; i += 2 * HEX_WORD_BYTES) {
+        hex_encode_word(dst + 2 * i, src + i, alpha);
+        hex_encode_word(dst + 2 * i + sizeof(hex_word_t), src + i + HEX_WORD_BYTES, alpha);
     }
 
-    if (numChars < decimalPlaces) {
-        return zxerr_encoding_failed;
+#if defined(ZXFORMAT_HEX_COMPACT)
+    for (; i < count; i++) {
+        dst[2 * i] = digits[src[i] >> 4u];
+        dst[2 * i + 1] = digits[src[i] & 0x0Fu];
     }
-    // add decimal point
-    const uint16_t pointPosition = numChars - decimalPlaces;
-    MEMMOVE(output + pointPosition + 1, output + pointPosition, decimalPlaces);  // shift content
-    output[pointPosition] = '.';
-    return zxerr_ok;
+#else
+    const char *pairs = uppercase ? HEX_PAIRS_UPPER : HEX_PAIRS_LOWER;
+    for (; i < count; i++) {
+        MEMCPY(dst + 2 * i, pairs + 2 * src[i], 2);
+    }
+#endif
 }
 
-size_t z_strlen(const char *buffer, size_t maxSize) {
-    if (buffer == NULL) return 0;
-    return strnlen(buffer, maxSize);
+#define IS_UTF8_CONTINUATION(c) ((((uint8_t)(c)) & 0xC0u) == 0x80u)
+#define IS_UTF8_LEAD(c) ((((uint8_t)(c)) & 0xC0u) == 0xC0u)
+
+// Start of the page following the one at start: start + pageLen moved back to a codepoint boundary.
+// The cut stays put when the page cannot hold the codepoint or the bytes are not valid UTF-8.
+static uint16_t page_next_start(const char *data, uint16_t dataLen, uint16_t start, uint16_t pageLen) {
+    if ((uint32_t)start + pageLen >= dataLen) {
+        return dataLen;
+    }
+    const uint16_t end = start + pageLen;
+
+    uint16_t cut = end;
+    for (uint8_t i = 0; i < 3 && cut > start && IS_UTF8_CONTINUATION(data[cut]); i++) {
+        cut--;
+    }
+    // Continuation bytes that do not follow a lead byte are stray, not part of a codepoint
+    if (cut == end || cut == start || !IS_UTF8_LEAD(data[cut])) {
+        return end;
+    }
+    return cut;
 }
 
-zxerr_t z_str3join(char *buffer, size_t bufferSize, const char *prefix, const char *suffix) {
-    size_t messageSize = z_strlen(buffer, bufferSize);
-    const size_t prefixSize = z_strlen(prefix, bufferSize);
-    const size_t suffixSize = z_strlen(suffix, bufferSize);
+// Sum of the 2-bit fields of x
+static uint16_t page_shift_sum(uint32_t x) {
+    x = (x & 0x33333333u) + ((x >> 2u) & 0x33333333u);
+    x = (x + (x >> 4u)) & 0x0F0F0F0Fu;
+    return (uint16_t)((x * 0x01010101u) >> 24u);
+}
+
+static uint16_t page_start(const page_table_t *pt, uint8_t pageIdx) {
+    const uint16_t start = (uint16_t)(pageIdx * pt->pageLen);
+    if (pt->uniform) {
+        return start;
+    }
+    const uint8_t word = pageIdx / 16u;
+    const uint8_t fields = pageIdx % 16u;
+    const uint32_t mask = fields == 0 ? 0 : (0xFFFFFFFFu >> (32u - 2u * fields));
+    return (uint16_t)(start - pt->shiftBase[word] - page_shift_sum(pt->shifts[word] & mask));
+}
+
+void page_table_init(page_table_t *pt, const char *data, uint16_t dataLen, uint16_t outValueLen) {
+    MEMZERO(pt, sizeof(*pt));
+    pt->uniform = bool_true;
+    // leave space for NULL termination
+    if (data == NULL || dataLen == 0 || outValueLen < 2) {
+        return;
+    }
+    pt->data = data;
+    pt->dataLen = dataLen;
+    pt->pageLen = outValueLen - 1;
+
+    // Closed form until a boundary lands inside a codepoint
+    uint32_t end = pt->pageLen;
+    while (end < dataLen && !IS_UTF8_CONTINUATION(data[end])) {
+        end += pt->pageLen;
+    }
+    const uint32_t uniformPages = end >= dataLen ? (dataLen + pt->pageLen - 1u) / pt->pageLen : end / pt->pageLen - 1u;
+    pt->pageCount = (uint8_t)(uniformPages < UINT8_MAX ? uniformPages : UINT8_MAX);
+    if (end >= dataLen || pt->pageCount == UINT8_MAX) {
+        return;
+    }
+
+    uint16_t start = (uint16_t)(end - pt->pageLen);
+    uint16_t total = 0;
+    while (start < dataLen && pt->pageCount < UINT8_MAX) {
+        const uint8_t word = pt->pageCount / 16u;
+        if (pt->pageCount % 16u == 0) {
+            pt->shiftBase[word] = total;
+        }
+        const uint16_t next = page_next_start(data, dataLen, start, pt->pageLen);
+        if (next < dataLen && next != start + pt->pageLen) {
+            const uint32_t shift = (uint32_t)(start + pt->pageLen - next);
+            pt->shifts[word] |= shift << (2u * (pt->pageCount % 16u));
+            total = (uint16_t)(total + shift);
+            pt->uniform = bool_false;
+        }
+        start = next;
+        pt->pageCount++;
+    }
+}
+
+void page_table_get(const page_table_t *pt, char *outValue, uint16_t outValueLen, uint8_t pageIdx) {
+    MEMZERO(outValue, outValueLen);
+    if (pageIdx >= pt->pageCount || outValueLen <= pt->pageLen) {
+        return;
+    }
+
+    const uint16_t start = page_start(pt, pageIdx);
+    const uint16_t end = page_next_start(pt->data, pt->dataLen, start, pt->pageLen);
+    MEMCPY(outValue, pt->data + start, end - start);
+}
+
+void pageStringExt(char *outValue, uint16_t outValueLen, const char *inValue, uint16_t inValueLen, uint8_t pageIdx,
+                   uint8_t *pageCount) {
+    MEMZERO(outValue, outValueLen);
+    *pageCount = 0;
+    // leave space for NULL termination
+    if (inValue == NULL || inValueLen == 0 || outValueLen < 2) {
+        return;
+    }
+    const uint16_t pageLen = outValueLen - 1;
 
-    size_t requiredSize = 1 /* termination */ + messageSize + prefixSize + suffixSize;
+    uint16_t start = 0;
+    while (start < inValueLen && *pageCount < UINT8_MAX) {
+        const uint16_t next = page_next_start(inValue, inValueLen, start, pageLen);
+        if (*pageCount == pageIdx) {
+            MEMCPY(outValue, inValue + start, next - start);
+        }
+        start = next;
+        (*pageCount)++;
+    }
+}
+
+zxerr_t formatBufferData(const uint8_t *ptr, uint64_t len, char *outValue, uint16_t outValueLen, uint8_t pageIdx,
+                         uint8_t *pageCount) {
+    if (outValue == NULL || pageCount == NULL || (ptr == NULL && len > 0)) {
+        return zxerr_no_data;
+    }
+    MEMZERO(outValue, outValueLen);
+    *pageCount = 0;
+    CHECK_APP_CANARY()
 
-    if (bufferSize < requiredSize) {
-        snprintf(buffer, bufferSize, "ERR???");
+    // leave space for NULL termination
+    if (outValueLen < 2 || len == 0) {
+        return zxerr_ok;
+    }
+    const uint16_t pageLen = outValueLen - 1;
+
+#if SIZE_MAX < UINT64_MAX
+    if (len > SIZE_MAX) {
         return zxerr_buffer_too_small;
     }
+#endif
+    // Check we have all ascii
+    const bool_t allAscii = zx_swar_find_outside(ptr, (size_t)len, 32, 127) == len ? bool_true : bool_false;
 
-    if (suffixSize > 0) {
-        memmove(buffer + messageSize, suffix, suffixSize);
-        buffer[messageSize + suffixSize] = 0;
+    // Characters of the rendered string: the data itself or "0x" and two hex digits per byte
+    if (!allAscii && len > (UINT64_MAX - 2) / 2) {
+        return zxerr_buffer_too_small;
+    }
+    const uint64_t total = allAscii ? len : 2 + 2 * len;
+    const uint64_t pages = (total + pageLen - 1) / pageLen;
+    if (pages > UINT8_MAX) {
+        return zxerr_buffer_too_small;
+    }
+    *pageCount = (uint8_t)pages;
+    if (pageIdx >= pages) {
+        return zxerr_ok;
     }
 
-    // shift and add prefix
-    if (prefixSize > 0) {
-        memmove(buffer + prefixSize, buffer, messageSize + suffixSize + 1);
-        memmove(buffer, prefix, prefixSize);
+    uint64_t first = (uint64_t)pageIdx * pageLen;
+    uint16_t n = (uint16_t)(total - first < pageLen ? total - first : pageLen);
+    if (allAscii) {
+        MEMCPY(outValue, ptr + first, n);
+        return zxerr_ok;
+    }
+
+    char *out = outValue;
+    for (; first < 2 && n > 0; first++, n--) {
+        *out++ = "0x"[first];
+    }
+
+    // Hex digits, possibly starting and ending in the middle of a byte
+    uint64_t digit = first - 2;
+    char pair[2];
+    if (n > 0 && (digit & 1u) != 0) {
+        array_to_hexchars(pair, ptr + digit / 2, 1, false);
+        *out++ = pair[1];
+        digit++;
+        n--;
+    }
+    array_to_hexchars(out, ptr + digit / 2, n / 2, false);
+    out += n - (n & 1u);
+    digit += n - (n & 1u);
+    if ((n & 1u) != 0) {
+        array_to_hexchars(pair, ptr + digit / 2, 1, false);
+        *out = pair[0];
     }
 
     return zxerr_ok;
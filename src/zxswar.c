@@ -0,0 +1,106 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include "zxswar.h"
+
+#include <string.h>
+
+#include "zxmacros.h"
+
+#if UINTPTR_MAX > 0xFFFFFFFFu
+typedef uint64_t swar_word_t;
+#else
+typedef uint32_t swar_word_t;
+#endif
+
+#define SWAR_REP8(b) ((swar_word_t)-1 / 0xFFu * (swar_word_t)(b))
+#define SWAR_HIGH SWAR_REP8(0x80u)
+#define SWAR_LOW7 SWAR_REP8(0x7Fu)
+
+__Z_INLINE swar_word_t swar_load(const uint8_t *p) {
+    swar_word_t w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+// High bit set in every byte of w inside [lo, hi] (hi <= 0x7F). Bytes are masked to 7 bits first, so no
+// addition carries into the next byte.
+__Z_INLINE swar_word_t swar_in_range(swar_word_t w, uint8_t lo, uint8_t hi) {
+    const swar_word_t low = w & SWAR_LOW7;
+    const swar_word_t geLo = low + SWAR_REP8(0x80u - lo);
+    const swar_word_t gtHi = low + SWAR_REP8(0x7Fu - hi);
+    return geLo & ~gtHi & ~w & SWAR_HIGH;
+}
+
+size_t zx_swar_find_outside(const uint8_t *data, size_t len, uint8_t lo, uint8_t hi) {
+    size_t i = 0;
+    for (; i + sizeof(swar_word_t) <= len; i += sizeof(swar_word_t)) {
+        if (swar_in_range(swar_load(data + i), lo, hi) != SWAR_HIGH) {
+            break;
+        }
+    }
+    for (; i < len; i++) {
+        if (data[i] < lo || data[i] > hi) {
+            return i;
+        }
+    }
+    return len;
+}
+
+size_t zx_swar_find_non_printable(const uint8_t *data, size_t len) {
+    return zx_swar_find_outside(data, len, 0x20u, 0x7Eu);
+}
+
+bool_t zx_swar_all_printable(const uint8_t *data, size_t len) {
+    return zx_swar_find_non_printable(data, len) == len ? bool_true : bool_false;
+}
+
+size_t zx_swar_find_zero(const uint8_t *data, size_t len) {
+    size_t i = 0;
+    for (; i + sizeof(swar_word_t) <= len; i += sizeof(swar_word_t)) {
+        const swar_word_t w = swar_load(data + i);
+        if (((w - SWAR_REP8(0x01u)) & ~w & SWAR_HIGH) != 0) {
+            break;
+        }
+    }
+    for (; i < len; i++) {
+        if (data[i] == 0) {
+            return i;
+        }
+    }
+    return len;
+}
+
+// Flips bit 5 (the ASCII case bit) of every byte in [lo, hi]
+static void swar_flip_case(uint8_t *data, size_t len, uint8_t lo, uint8_t hi) {
+    size_t i = 0;
+    for (; i + sizeof(swar_word_t) <= len; i += sizeof(swar_word_t)) {
+        const swar_word_t w = swar_load(data + i);
+        const swar_word_t letters = swar_in_range(w, lo, hi);
+        if (letters != 0) {
+            const swar_word_t folded = w ^ (letters >> 2u);
+            memcpy(data + i, &folded, sizeof(folded));
+        }
+    }
+    for (; i < len; i++) {
+        if (data[i] >= lo && data[i] <= hi) {
+            data[i] ^= 0x20u;
+        }
+    }
+}
+
+void zx_swar_to_upper(uint8_t *data, size_t len) { swar_flip_case(data, len, 'a', 'z'); }
+
+void zx_swar_to_lower(uint8_t *data, size_t len) { swar_flip_case(data, len, 'A', 'Z'); }
@@ -17,6 +17,12 @@
 #include <zxformat.h>
 #include <zxmacros.h>
 
+#include <random>
+#include <string>
+
+#include "test_utils.h"
+#include "utf8.h"
+
 namespace {
 TEST(ASCIIFY, pure) {
     char input[] = "This is only ascii";
@@ -116,4 +122,90 @@ TEST(ASCIIFY, inplace_utf8) {
     EXPECT_STREQ(want, data);
 }
 
+// Previous implementation: revalidates the rest of the string before every codepoint
+size_t legacy_asciify_ext(const char *utf8_in, char *ascii_only_out) {
+    void *p = (void *)utf8_in;
+    char *q = ascii_only_out;
+    while (*((char *)p) && utf8valid((const utf8_int8_t *)p) == 0) {
+        utf8_int32_t tmp_codepoint = 0;
+        p = utf8codepoint((const utf8_int8_t *)p, &tmp_codepoint);
+        *q = (char)((tmp_codepoint >= 32 && tmp_codepoint <= (int32_t)0x7F) ? tmp_codepoint : '.');
+        q++;
+    }
+    *q = 0;
+    return q - ascii_only_out;
+}
+
+TEST(ASCIIFY, matches_legacy) {
+    std::mt19937 rng(21);
+    const std::string pieces[] = {"a", "hello world ", "\x05", "\x7f", "\xC3\xB1", "\xE5\x93\x88", "\xF0\x9F\x98\x80",
+                                  "\xC0\xAF", "\xE0\x80\xAF", "\xF0\x80\x80\xAF", "\x80", "\xC3", "\xE5\x93", "\xFF",
+                                  "\xF4\x90\x80\x80", "\xED\xA0\x80"};
+    for (size_t iter = 0; iter < 20000; iter++) {
+        std::string input;
+        const size_t count = rng() % 12;
+        for (size_t i = 0; i < count; i++) {
+            // Mostly valid pieces, sometimes a malformed one or a random byte
+            const size_t pick = rng() % 100;
+            if (pick < 80) {
+                input += pieces[rng() % 7];
+            } else if (pick < 95) {
+                input += pieces[rng() % 16];
+            } else {
+                input += (char)(1 + rng() % 255);
+            }
+        }
+
+        std::vector<char> expected(input.size() + 1), actual(input.size() + 1);
+        const size_t expectedLen = legacy_asciify_ext(input.c_str(), expected.data());
+        ASSERT_EQ(asciify_ext(input.c_str(), actual.data()), expectedLen);
+        ASSERT_STREQ(actual.data(), expected.data());
+    }
+}
+
+TEST(ASCIIFY, explicit_length) {
+    const char input[] = "ab\0c\xC3\xB1" "12345678\x01xyz";
+    char have[32];
+
+    // A NUL inside the input is a control character like any other
+    EXPECT_EQ(asciify_ext_n(input, sizeof(input) - 1, have), 17u);
+    EXPECT_STREQ(have, "ab.c.12345678.xyz");
+
+    // Only len bytes are read, so a sequence cut by len is invalid
+    EXPECT_EQ(asciify_ext_n(input, 5, have), 0u);
+    EXPECT_STREQ(have, "");
+    EXPECT_EQ(asciify_ext_n(input, 4, have), 4u);
+    EXPECT_STREQ(have, "ab.c");
+}
+
+TEST(ASCIIFY, DISABLED_benchmark) {
+    std::mt19937 rng(2121);
+    std::string ascii, mixed, adversarial;
+    while (ascii.size() < 2048) {
+        ascii += "Transfer 10 ATOM to the validator. ";
+    }
+    while (mixed.size() < 2048) {
+        mixed += (rng() % 4 == 0) ? "\xC3\xB1" : "memo ";
+    }
+    // Every codepoint is multi-byte, so there is no ASCII run to skip and the legacy loop revalidates it all
+    while (adversarial.size() < 2048) {
+        adversarial += "\xE5\x93\x88";
+    }
+
+    std::vector<char> out(4096);
+    volatile size_t sink = 0;
+
+    std::cout << "input\t\tbytes\tlegacy[us]\tasciify_ext_n[us]" << std::endl;
+    for (const auto &entry : {std::make_pair("ascii", &ascii), std::make_pair("mixed", &mixed),
+                              std::make_pair("adversarial", &adversarial)}) {
+        const std::string &in = *entry.second;
+        const double legacy =
+            bench_ns([&]() { sink = sink + legacy_asciify_ext(in.c_str(), out.data()); }, 20) / 1000.0;
+        const double fast =
+            bench_ns([&]() { sink = sink + asciify_ext_n(in.c_str(), in.size(), out.data()); }, 2000) / 1000.0;
+        std::cout << entry.first << "\t" << (strlen(entry.first) < 8 ? "\t" : "") << in.size() << "\t" << legacy
+                  << "\t\t" << fast << std::endl;
+    }
+}
+
 }  // namespace
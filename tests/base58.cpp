@@ -0,0 +1,614 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <base58.h>
+#include <hexutils.h>
+
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "test_utils.h"
+
+namespace {
+
+// Byte-at-a-time carry encoder, kept as reference for differential tests and benchmarks
+int legacy_encode_base58(const unsigned char *in, size_t length, unsigned char *out, size_t *outlen) {
+    static const char alphabet[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+    unsigned char buffer[120 * 138 / 100 + 1] = {0};
+    size_t zeroCount = 0;
+
+    if (length > 120) {
+        return -1;
+    }
+    while ((zeroCount < length) && (in[zeroCount] == 0)) {
+        ++zeroCount;
+    }
+
+    const size_t outputSize = (length - zeroCount) * 138 / 100 + 1;
+    size_t stopAt = outputSize - 1;
+    size_t j;
+    for (size_t startAt = zeroCount; startAt < length; startAt++) {
+        int carry = in[startAt];
+        for (j = outputSize - 1; (int)j >= 0; j--) {
+            carry += 256 * buffer[j];
+            buffer[j] = carry % 58;
+            carry /= 58;
+            if (j <= stopAt - 1 && carry == 0) {
+                break;
+            }
+        }
+        stopAt = j;
+    }
+
+    j = 0;
+    while (j < outputSize && buffer[j] == 0) {
+        j += 1;
+    }
+    if (*outlen < zeroCount + outputSize - j) {
+        *outlen = zeroCount + outputSize - j;
+        return -1;
+    }
+
+    memset(out, alphabet[0], zeroCount);
+    size_t i = zeroCount;
+    while (j < outputSize) {
+        out[i++] = alphabet[buffer[j++]];
+    }
+    *outlen = i;
+    return 0;
+}
+
+// Byte-at-a-time decoder, kept as reference for differential tests
+int legacy_decode_base58(const char *in, size_t length, unsigned char *out, size_t *outlen) {
+    std::vector<uint8_t> tmp(length);
+    std::vector<uint8_t> buffer(length, 0);
+    size_t zeroCount = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        const char *p = strchr("123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz", in[i]);
+        if (in[i] == 0 || p == nullptr) {
+            return -1;
+        }
+        tmp[i] = static_cast<uint8_t>(p - "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz");
+    }
+    while ((zeroCount < length) && (tmp[zeroCount] == 0)) {
+        ++zeroCount;
+    }
+    size_t j = length;
+    size_t startAt = zeroCount;
+    while (startAt < length) {
+        unsigned short remainder = 0;
+        for (size_t divLoop = startAt; divLoop < length; divLoop++) {
+            const unsigned short tmpDiv = remainder * 58 + tmp[divLoop];
+            tmp[divLoop] = (unsigned char)(tmpDiv / 256);
+            remainder = (tmpDiv % 256);
+        }
+        if (tmp[startAt] == 0) {
+            ++startAt;
+        }
+        buffer[--j] = (unsigned char)remainder;
+    }
+    while ((j < length) && (buffer[j] == 0)) {
+        ++j;
+    }
+    length = length - (j - zeroCount);
+    if (*outlen < length) {
+        return -1;
+    }
+    if (length > 0) {
+        memcpy(out, buffer.data() + j - zeroCount, length);
+    }
+    *outlen = length;
+    return 0;
+}
+
+typedef struct {
+    std::string hex;
+    std::string expected;
+} base58_testcase_t;
+
+class Base58EncodeTests : public ::testing::TestWithParam<base58_testcase_t> {};
+
+INSTANTIATE_TEST_SUITE_P(
+    Base58TestCases, Base58EncodeTests,
+    testing::Values(base58_testcase_t{"", ""}, base58_testcase_t{"61", "2g"}, base58_testcase_t{"626262", "a3gV"},
+                    base58_testcase_t{"636363", "aPEr"}, base58_testcase_t{"572e4794", "3EFU7m"},
+                    base58_testcase_t{"10c8511e", "Rt5zm"}, base58_testcase_t{"516b6fcd0f", "ABnLTmg"},
+                    base58_testcase_t{"bf4f89001e670274dd", "3SEo3LWLoPntC"},
+                    base58_testcase_t{"ecac89cad93923c02321", "EJDM8drfXA6uyA"},
+                    base58_testcase_t{"00000000000000000000", "1111111111"},
+                    base58_testcase_t{"0000287fb4cd", "11233QC4"},
+                    base58_testcase_t{"73696d706c792061206c6f6e6720737472696e67", "2cFupjhnEsSn59qHXstmK2ffpLv2"},
+                    base58_testcase_t{"00eb15231dfceb60925886b67d065299925915aeb172c06647",
+                                      "1NS17iag9jJgTHD1VXjvLCEnZuQ3rJDE9L"}));
+
+TEST_P(Base58EncodeTests, encode) {
+    const auto testcase = GetParam();
+
+    uint8_t inBuffer[100];
+    const auto inLen = parseHexString(inBuffer, sizeof(inBuffer), testcase.hex.c_str());
+
+    unsigned char out[200];
+    size_t outLen = sizeof(out);
+    ASSERT_EQ(encode_base58(inBuffer, inLen, out, &outLen), 0);
+    ASSERT_EQ(outLen, testcase.expected.size());
+    ASSERT_EQ(std::string(reinterpret_cast<char *>(out), outLen), testcase.expected);
+}
+
+TEST(BASE58, encode_matches_legacy) {
+    std::mt19937 rng(1234);
+
+    for (size_t len = 0; len <= 120; len++) {
+        for (size_t zeros = 0; zeros <= 3 && zeros <= len; zeros++) {
+            auto data = random_bytes(rng, len);
+            std::fill(data.begin(), data.begin() + zeros, 0);
+
+            unsigned char expected[200];
+            size_t expectedLen = sizeof(expected);
+            ASSERT_EQ(legacy_encode_base58(data.data(), len, expected, &expectedLen), 0);
+
+            unsigned char out[200];
+            size_t outLen = sizeof(out);
+            ASSERT_EQ(encode_base58(data.data(), len, out, &outLen), 0) << "len " << len;
+            ASSERT_EQ(outLen, expectedLen) << "len " << len;
+            ASSERT_EQ(memcmp(out, expected, outLen), 0) << "len " << len;
+        }
+    }
+}
+
+TEST(BASE58, encode_output_too_small) {
+    const uint8_t data[32] = {0x00, 0x00, 0xAB, 0xCD};
+
+    unsigned char expected[100];
+    size_t expectedLen = sizeof(expected);
+    ASSERT_EQ(encode_base58(data, sizeof(data), expected, &expectedLen), 0);
+
+    unsigned char out[100];
+    size_t outLen = expectedLen - 1;
+    ASSERT_EQ(encode_base58(data, sizeof(data), out, &outLen), -1);
+    // On failure the required size is reported back
+    ASSERT_EQ(outLen, expectedLen);
+}
+
+TEST(BASE58, encode_input_too_large) {
+    const std::vector<uint8_t> data(121, 0x55);
+    unsigned char out[300];
+    size_t outLen = sizeof(out);
+    ASSERT_EQ(encode_base58(data.data(), data.size(), out, &outLen), -1);
+}
+
+TEST(BASE58, fixed_width_matches_legacy) {
+    std::mt19937 rng(5678);
+
+    for (const size_t width : {32, 64}) {
+        for (size_t zeros = 0; zeros <= width; zeros++) {
+            auto data = random_bytes(rng, width);
+            std::fill(data.begin(), data.begin() + zeros, 0);
+
+            unsigned char expected[200];
+            size_t expectedLen = sizeof(expected);
+            ASSERT_EQ(legacy_encode_base58(data.data(), width, expected, &expectedLen), 0);
+
+            unsigned char encoded[200];
+            size_t encodedLen = sizeof(encoded);
+            const int err = width == 32 ? encode_base58_32(data.data(), encoded, &encodedLen)
+                                        : encode_base58_64(data.data(), encoded, &encodedLen);
+            ASSERT_EQ(err, 0);
+            ASSERT_EQ(encodedLen, expectedLen);
+            ASSERT_EQ(memcmp(encoded, expected, encodedLen), 0) << "width " << width << " zeros " << zeros;
+
+            uint8_t decoded[64];
+            size_t decodedLen = sizeof(decoded);
+            const char *str = reinterpret_cast<const char *>(encoded);
+            ASSERT_EQ(width == 32 ? decode_base58_32(str, encodedLen, decoded, &decodedLen)
+                                  : decode_base58_64(str, encodedLen, decoded, &decodedLen),
+                      0);
+            ASSERT_EQ(decodedLen, width);
+            ASSERT_EQ(memcmp(decoded, data.data(), width), 0);
+
+            // Generic entry point dispatches to the same result
+            decodedLen = sizeof(decoded);
+            ASSERT_EQ(decode_base58(str, encodedLen, decoded, &decodedLen), 0);
+            ASSERT_EQ(decodedLen, width);
+            ASSERT_EQ(memcmp(decoded, data.data(), width), 0);
+        }
+    }
+}
+
+TEST(BASE58, fixed_width_decode_rejects_other_sizes) {
+    // 43 characters holding a 31-byte value
+    const std::string s31 = "1111111111111111111111111111111111111111112";
+    // 44 characters above 2^256
+    const std::string big = "zzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzz";
+
+    for (const auto &s : {s31, big}) {
+        uint8_t out[64];
+        size_t outLen = sizeof(out);
+        ASSERT_EQ(decode_base58_32(s.c_str(), s.size(), out, &outLen), -1);
+
+        // The generic decoder still handles them like before
+        uint8_t expected[64];
+        size_t expectedLen = sizeof(expected);
+        ASSERT_EQ(legacy_decode_base58(s.c_str(), s.size(), expected, &expectedLen), 0);
+        outLen = sizeof(out);
+        ASSERT_EQ(decode_base58(s.c_str(), s.size(), out, &outLen), 0);
+        ASSERT_EQ(outLen, expectedLen);
+        ASSERT_EQ(memcmp(out, expected, outLen), 0);
+    }
+
+    const std::string invalid = "0OIl111111111111111111111111111111111111111";
+    uint8_t out[64];
+    size_t outLen = sizeof(out);
+    ASSERT_EQ(decode_base58_32(invalid.c_str(), invalid.size(), out, &outLen), -1);
+    ASSERT_EQ(decode_base58(invalid.c_str(), invalid.size(), out, &outLen), -1);
+
+    // Output buffer must hold the full width
+    const std::string ones(32, '1');
+    outLen = 31;
+    ASSERT_EQ(decode_base58_32(ones.c_str(), ones.size(), out, &outLen), -1);
+}
+
+TEST(BASE58, decode_matches_legacy) {
+    std::mt19937 rng(4321);
+    const char alphabet[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+    for (size_t len = 0; len <= 164; len++) {
+        std::string s(len, '1');
+        for (size_t i = len / 8; i < len; i++) {
+            s[i] = alphabet[rng() % 58];
+        }
+
+        uint8_t expected[200];
+        size_t expectedLen = sizeof(expected);
+        ASSERT_EQ(legacy_decode_base58(s.c_str(), len, expected, &expectedLen), 0);
+
+        uint8_t out[200];
+        size_t outLen = sizeof(out);
+        ASSERT_EQ(decode_base58(s.c_str(), len, out, &outLen), 0) << "len " << len;
+        ASSERT_EQ(outLen, expectedLen) << "len " << len;
+        ASSERT_EQ(memcmp(out, expected, outLen), 0) << "len " << len;
+
+        // Output buffer sized exactly to the result is enough
+        outLen = expectedLen;
+        ASSERT_EQ(decode_base58(s.c_str(), len, out, &outLen), 0) << "len " << len;
+        if (expectedLen > 0) {
+            outLen = expectedLen - 1;
+            ASSERT_EQ(decode_base58(s.c_str(), len, out, &outLen), -1) << "len " << len;
+        }
+    }
+}
+
+TEST(BASE58, ex_long_inputs) {
+    std::mt19937 rng(777);
+
+    for (const size_t len : {121, 200, 333, 1000}) {
+        auto data = random_bytes(rng, len);
+        data[0] = 0;
+        data[1] = 0;
+
+        std::vector<uint32_t> encScratch(BASE58_ENCODE_SCRATCH_LIMBS(len));
+        std::vector<unsigned char> encoded(len * 2);
+        size_t encodedLen = encoded.size();
+        ASSERT_EQ(encode_base58_ex(data.data(), len, encoded.data(), &encodedLen, encScratch.data(), encScratch.size()),
+                  0);
+        ASSERT_EQ(encoded[0], '1');
+        ASSERT_EQ(encoded[1], '1');
+        ASSERT_NE(encoded[2], '1');
+
+        const char *str = reinterpret_cast<const char *>(encoded.data());
+        std::vector<uint8_t> expected(len);
+        size_t expectedLen = expected.size();
+        ASSERT_EQ(legacy_decode_base58(str, encodedLen, expected.data(), &expectedLen), 0);
+        ASSERT_EQ(expectedLen, len);
+        ASSERT_EQ(memcmp(expected.data(), data.data(), len), 0);
+
+        std::vector<unsigned char> decScratch(BASE58_DECODE_SCRATCH_LEN(encodedLen));
+        std::vector<uint8_t> decoded(len);
+        size_t decodedLen = decoded.size();
+        ASSERT_EQ(decode_base58_ex(str, encodedLen, decoded.data(), &decodedLen, decScratch.data(), decScratch.size()),
+                  0);
+        ASSERT_EQ(decodedLen, len);
+        ASSERT_EQ(memcmp(decoded.data(), data.data(), len), 0);
+
+        // Scratch too small
+        encodedLen = encoded.size();
+        ASSERT_EQ(encode_base58_ex(data.data(), len, encoded.data(), &encodedLen, encScratch.data(),
+                                   encScratch.size() / 2),
+                  -1);
+        decodedLen = decoded.size();
+        ASSERT_EQ(decode_base58_ex(str, encodedLen, decoded.data(), &decodedLen, decScratch.data(),
+                                   decScratch.size() - 1),
+                  -1);
+    }
+}
+
+TEST(BASE58, ex_matches_fixed_size_api) {
+    std::mt19937 rng(888);
+
+    for (size_t len = 0; len <= 120; len++) {
+        const auto data = random_bytes(rng, len);
+
+        unsigned char expected[200];
+        size_t expectedLen = sizeof(expected);
+        ASSERT_EQ(encode_base58(data.data(), len, expected, &expectedLen), 0);
+
+        uint32_t scratch[BASE58_ENCODE_SCRATCH_LIMBS(120)];
+        unsigned char out[200];
+        size_t outLen = sizeof(out);
+        ASSERT_EQ(encode_base58_ex(data.data(), len, out, &outLen, scratch, BASE58_ENCODE_SCRATCH_LIMBS(len)), 0);
+        ASSERT_EQ(outLen, expectedLen);
+        ASSERT_EQ(memcmp(out, expected, outLen), 0);
+    }
+}
+
+// Simple stand-in for a real hash, only the plumbing is under test
+int test_checksum(const unsigned char *prefix, size_t prefixLen, const unsigned char *payload, size_t payloadLen,
+                  unsigned char *checksum, size_t checksumLen) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < prefixLen; i++) {
+        h = (h ^ prefix[i]) * 16777619u;
+    }
+    for (size_t i = 0; i < payloadLen; i++) {
+        h = (h ^ payload[i]) * 16777619u;
+    }
+    for (size_t i = 0; i < checksumLen; i++) {
+        checksum[i] = static_cast<unsigned char>(h >> (8 * (i % 4)));
+        h = h * 16777619u + 1;
+    }
+    return 0;
+}
+
+TEST(BASE58, check_roundtrip) {
+    std::mt19937 rng(91);
+
+    for (const size_t checksumLen : {1, 2, 4}) {
+        for (const size_t versionLen : {0, 1, 2}) {
+            for (size_t payloadLen = 0; payloadLen <= 64; payloadLen += 7) {
+                const auto version = random_bytes(rng, versionLen);
+                auto payload = random_bytes(rng, payloadLen);
+                if (payloadLen > 0) {
+                    payload[0] = 0;
+                }
+
+                // Reference: build the concatenation and use the plain encoder
+                std::vector<uint8_t> full(version);
+                full.insert(full.end(), payload.begin(), payload.end());
+                std::vector<uint8_t> digest(checksumLen);
+                test_checksum(version.data(), versionLen, payload.data(), payloadLen, digest.data(), checksumLen);
+                full.insert(full.end(), digest.begin(), digest.end());
+
+                unsigned char expected[200];
+                size_t expectedLen = sizeof(expected);
+                ASSERT_EQ(encode_base58(full.data(), full.size(), expected, &expectedLen), 0);
+
+                unsigned char encoded[200];
+                size_t encodedLen = sizeof(encoded);
+                ASSERT_EQ(encode_base58check(version.data(), versionLen, payload.data(), payloadLen, checksumLen,
+                                             test_checksum, encoded, &encodedLen),
+                          0);
+                ASSERT_EQ(encodedLen, expectedLen);
+                ASSERT_EQ(memcmp(encoded, expected, encodedLen), 0);
+
+                uint8_t decoded[200];
+                size_t decodedLen = sizeof(decoded);
+                ASSERT_EQ(decode_base58check(reinterpret_cast<const char *>(encoded), encodedLen, checksumLen,
+                                             test_checksum, decoded, &decodedLen),
+                          0);
+                ASSERT_EQ(decodedLen, versionLen + payloadLen);
+                ASSERT_EQ(memcmp(decoded, full.data(), decodedLen), 0);
+            }
+        }
+    }
+}
+
+TEST(BASE58, check_rejects_bad_checksum) {
+    const uint8_t version[] = {0x00};
+    const uint8_t payload[20] = {0x77, 0xbf, 0xf2, 0x0c, 0x60, 0xe5, 0x22, 0xdf, 0xaa, 0x33,
+                                 0x50, 0xc3, 0x9b, 0x03, 0x0a, 0x5d, 0x00, 0x4e, 0x83, 0x9a};
+
+    unsigned char encoded[100];
+    size_t encodedLen = sizeof(encoded);
+    ASSERT_EQ(encode_base58check(version, sizeof(version), payload, sizeof(payload), 4, test_checksum, encoded,
+                                 &encodedLen),
+              0);
+
+    // Swap one character for a different valid one
+    encoded[encodedLen - 1] = encoded[encodedLen - 1] == '2' ? '3' : '2';
+
+    uint8_t decoded[100];
+    size_t decodedLen = sizeof(decoded);
+    ASSERT_EQ(decode_base58check(reinterpret_cast<const char *>(encoded), encodedLen, 4, test_checksum, decoded,
+                                 &decodedLen),
+              -1);
+
+    // Too short to hold the checksum
+    decodedLen = sizeof(decoded);
+    ASSERT_EQ(decode_base58check("2g", 2, 4, test_checksum, decoded, &decodedLen), -1);
+
+    // Output must hold version || payload
+    encodedLen = sizeof(encoded);
+    ASSERT_EQ(encode_base58check(version, sizeof(version), payload, sizeof(payload), 4, test_checksum, encoded,
+                                 &encodedLen),
+              0);
+    decodedLen = sizeof(version) + sizeof(payload) - 1;
+    ASSERT_EQ(decode_base58check(reinterpret_cast<const char *>(encoded), encodedLen, 4, test_checksum, decoded,
+                                 &decodedLen),
+              -1);
+}
+
+class Base58BlockTests : public ::testing::TestWithParam<base58_testcase_t> {};
+
+INSTANTIATE_TEST_SUITE_P(
+    Base58BlockTestCases, Base58BlockTests,
+    testing::Values(base58_testcase_t{"", ""}, base58_testcase_t{"00", "11"}, base58_testcase_t{"39", "1z"},
+                    base58_testcase_t{"ff", "5Q"}, base58_testcase_t{"0000", "111"},
+                    base58_testcase_t{"0100", "15R"}, base58_testcase_t{"ffff", "LUv"},
+                    base58_testcase_t{"ffffff", "2UzHL"}, base58_testcase_t{"ffffffff", "7YXq9G"},
+                    base58_testcase_t{"ffffffffff", "VtB5VXc"}, base58_testcase_t{"ffffffffffff", "3CUsUpv9t"},
+                    base58_testcase_t{"ffffffffffffff", "Ahg1opVcGW"},
+                    base58_testcase_t{"0000000000000039", "1111111111z"},
+                    base58_testcase_t{"ffffffffffffffff", "jpXCZedGfVQ"},
+                    base58_testcase_t{"05e022ba374b2a00", "1z111111111"},
+                    base58_testcase_t{"000000000000000000", "1111111111111"},
+                    base58_testcase_t{"06156013762879f7ffffffffff", "22222222222VtB5VXc"}));
+
+TEST_P(Base58BlockTests, encode_decode) {
+    const auto testcase = GetParam();
+
+    uint8_t inBuffer[100];
+    const auto inLen = parseHexString(inBuffer, sizeof(inBuffer), testcase.hex.c_str());
+
+    unsigned char out[200];
+    size_t outLen = sizeof(out);
+    ASSERT_EQ(encode_base58_block(inBuffer, inLen, out, &outLen), 0);
+    ASSERT_EQ(outLen, base58_block_encoded_len(inLen));
+    ASSERT_EQ(std::string(reinterpret_cast<char *>(out), outLen), testcase.expected);
+
+    uint8_t decoded[100];
+    size_t decodedLen = sizeof(decoded);
+    ASSERT_EQ(decode_base58_block(testcase.expected.c_str(), testcase.expected.size(), decoded, &decodedLen), 0);
+    ASSERT_EQ(decodedLen, inLen);
+    ASSERT_EQ(memcmp(decoded, inBuffer, inLen), 0);
+}
+
+TEST(BASE58, block_monero_address) {
+    const std::string address =
+        "44AFFq5kSiGBoZ4NMDwYtN18obc8AemS33DBLWs3H7otXft3XjrpDtQGv7SqSsaBYBb98uNbr2VBBEt7f2wfn3RVGQBEP3A";
+
+    uint8_t decoded[100];
+    size_t decodedLen = sizeof(decoded);
+    ASSERT_EQ(decode_base58_block(address.c_str(), address.size(), decoded, &decodedLen), 0);
+    ASSERT_EQ(decodedLen, 69);
+    // Mainnet standard address tag
+    ASSERT_EQ(decoded[0], 0x12);
+
+    unsigned char encoded[100];
+    size_t encodedLen = sizeof(encoded);
+    ASSERT_EQ(encode_base58_block(decoded, decodedLen, encoded, &encodedLen), 0);
+    ASSERT_EQ(std::string(reinterpret_cast<char *>(encoded), encodedLen), address);
+}
+
+TEST(BASE58, block_decode_invalid) {
+    uint8_t out[100];
+    size_t outLen = sizeof(out);
+
+    // 1, 4 and 8 characters are not valid last block sizes
+    ASSERT_EQ(decode_base58_block("1", 1, out, &outLen), -1);
+    ASSERT_EQ(decode_base58_block("1111", 4, out, &outLen), -1);
+    ASSERT_EQ(decode_base58_block("11111111111" "11111111", 19, out, &outLen), -1);
+    // 256 does not fit in one byte
+    ASSERT_EQ(decode_base58_block("5R", 2, out, &outLen), -1);
+    // Above 2^64
+    ASSERT_EQ(decode_base58_block("zzzzzzzzzzz", 11, out, &outLen), -1);
+    // Invalid character
+    ASSERT_EQ(decode_base58_block("1111111111O", 11, out, &outLen), -1);
+    // Output too small
+    outLen = 7;
+    ASSERT_EQ(decode_base58_block("jpXCZedGfVQ", 11, out, &outLen), -1);
+
+    unsigned char enc[10];
+    size_t encLen = sizeof(enc);
+    const uint8_t data[8] = {0};
+    ASSERT_EQ(encode_base58_block(data, sizeof(data), enc, &encLen), -1);
+    ASSERT_EQ(encLen, 11);
+}
+
+TEST(BASE58, DISABLED_benchmark_block_vs_whole_number) {
+    std::mt19937 rng(69);
+    const size_t iterations = 5000;
+    volatile size_t sink = 0;
+
+    std::cout << "len\twhole enc[MB/s]\tblock enc[MB/s]\twhole dec[MB/s]\tblock dec[MB/s]" << std::endl;
+    for (const size_t len : {69, 95}) {
+        const auto data = random_bytes(rng, len);
+        unsigned char whole[200];
+        size_t wholeLen = sizeof(whole);
+        ASSERT_EQ(encode_base58(data.data(), len, whole, &wholeLen), 0);
+        unsigned char block[200];
+        size_t blockLen = sizeof(block);
+        ASSERT_EQ(encode_base58_block(data.data(), len, block, &blockLen), 0);
+
+        unsigned char out[200];
+        const double wholeEnc = bench_ns(
+            [&]() {
+                size_t outLen = sizeof(out);
+                encode_base58(data.data(), len, out, &outLen);
+                sink = sink + outLen;
+            },
+            iterations);
+        const double blockEnc = bench_ns(
+            [&]() {
+                size_t outLen = sizeof(out);
+                encode_base58_block(data.data(), len, out, &outLen);
+                sink = sink + outLen;
+            },
+            iterations);
+        const double wholeDec = bench_ns(
+            [&]() {
+                size_t outLen = sizeof(out);
+                decode_base58(reinterpret_cast<const char *>(whole), wholeLen, out, &outLen);
+                sink = sink + outLen;
+            },
+            iterations);
+        const double blockDec = bench_ns(
+            [&]() {
+                size_t outLen = sizeof(out);
+                decode_base58_block(reinterpret_cast<const char *>(block), blockLen, out, &outLen);
+                sink = sink + outLen;
+            },
+            iterations);
+
+        // bytes per ns * 1000 = MB/s
+        std::cout << len << "\t" << len * 1000 / wholeEnc << "\t\t" << len * 1000 / blockEnc << "\t\t"
+                  << len * 1000 / wholeDec << "\t\t" << len * 1000 / blockDec << std::endl;
+    }
+}
+
+TEST(BASE58, DISABLED_benchmark_encode_vs_legacy) {
+    std::mt19937 rng(42);
+    const size_t iterations = 200;
+    volatile size_t sink = 0;
+
+    std::cout << "len\tlegacy[ns]\tlimbs[ns]\tspeedup" << std::endl;
+    for (size_t len = 1; len <= 120; len++) {
+        const auto data = random_bytes(rng, len);
+        unsigned char out[200];
+
+        const double legacy = bench_ns(
+            [&]() {
+                size_t outLen = sizeof(out);
+                legacy_encode_base58(data.data(), len, out, &outLen);
+                sink = sink + outLen;
+            },
+            iterations);
+        const double limbs = bench_ns(
+            [&]() {
+                size_t outLen = sizeof(out);
+                encode_base58(data.data(), len, out, &outLen);
+                sink = sink + outLen;
+            },
+            iterations);
+
+        if (len % 8 == 0 || len == 1) {
+            std::cout << len << "\t" << legacy << "\t\t" << limbs << "\t\t" << legacy / limbs << "x" << std::endl;
+        }
+    }
+}
+
+}  // namespace
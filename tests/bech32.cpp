@@ -14,12 +14,18 @@
  *  limitations under the License.
  ********************************************************************************/
 #include <bech32.h>
+#include <bittools.h>
 #include <gmock/gmock.h>
 #include <hexutils.h>
 #include <zxformat.h>
 #include <zxmacros.h>
 
 #include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "test_utils.h"
 
 namespace {
 TEST(BECH32, hex_to_address) {
@@ -728,4 +734,237 @@ TEST(BECH32, additional_comprehensive_cases) {
         ASSERT_STREQ(expected, addr_out);
     }
 }
+// Bitwise polymod from BIP173, used as a reference for the table-driven engine
+uint32_t reference_polymod(uint32_t chk, const uint8_t *values, size_t n) {
+    static const uint32_t gen[5] = {0x3b6a57b2, 0x26508e6d, 0x1ea119fa, 0x3d4233dd, 0x2a1462b3};
+    for (size_t i = 0; i < n; i++) {
+        const uint32_t top = chk >> 25;
+        chk = ((chk & 0x1ffffff) << 5) ^ values[i];
+        for (int j = 0; j < 5; j++) {
+            if ((top >> j) & 1) chk ^= gen[j];
+        }
+    }
+    return chk;
+}
+
+TEST(BECH32, checksum_update_matches_reference) {
+    std::mt19937 rng(1234);
+    for (size_t n = 0; n < 200; n++) {
+        std::vector<uint8_t> symbols(n);
+        for (auto &s : symbols) s = rng() & 0x1F;
+        const uint32_t start = (n == 0) ? 1 : (rng() & 0x3FFFFFFF);
+        ASSERT_EQ(bech32_checksum_update(start, symbols.data(), n), reference_polymod(start, symbols.data(), n))
+            << "n=" << n;
+
+        // splitting the input at an odd offset must not change the result
+        const size_t split = n / 2 | 1;
+        if (split <= n) {
+            const uint32_t partial = bech32_checksum_update(start, symbols.data(), split);
+            ASSERT_EQ(bech32_checksum_update(partial, symbols.data() + split, n - split),
+                      reference_polymod(start, symbols.data(), n));
+        }
+    }
+}
+
+TEST(BECH32, decode_valid_checksums) {
+    // BIP173 / BIP350 valid checksum vectors
+    const struct {
+        const char *input;
+        bech32_encoding enc;
+    } vectors[] = {
+        {"A12UEL5L", BECH32_ENCODING_BECH32},
+        {"a12uel5l", BECH32_ENCODING_BECH32},
+        {"an83characterlonghumanreadablepartthatcontainsthenumber1andtheexcludedcharactersbio1tt5tgs",
+         BECH32_ENCODING_BECH32},
+        {"abcdef1qpzry9x8gf2tvdw0s3jn54khce6mua7lmqqqxw", BECH32_ENCODING_BECH32},
+        {"11qqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqc8247j",
+         BECH32_ENCODING_BECH32},
+        {"split1checkupstagehandshakeupstreamerranterredcaperred2y9e3w", BECH32_ENCODING_BECH32},
+        {"A1LQFN3A", BECH32_ENCODING_BECH32M},
+        {"a1lqfn3a", BECH32_ENCODING_BECH32M},
+        {"abcdef1l7aum6echk45nj3s0wdvt2fg8x9yrzpqzd3ryx", BECH32_ENCODING_BECH32M},
+        {"split1checkupstagehandshakeupstreamerranterredcaperredlc445v", BECH32_ENCODING_BECH32M},
+        {"?1v759aa", BECH32_ENCODING_BECH32M},
+    };
+
+    for (const auto &v : vectors) {
+        char hrp[100];
+        uint8_t data[100];
+        size_t data_len = 0;
+        ASSERT_EQ(bech32_decode(hrp, data, &data_len, v.input), v.enc) << v.input;
+
+        // re-encoding gives back the lowercase input
+        char out[100];
+        ASSERT_EQ(bech32_encode(out, hrp, data, data_len, v.enc), 1) << v.input;
+        std::string expected(v.input);
+        for (auto &c : expected) c = tolower(c);
+        ASSERT_EQ(expected, out);
+    }
+
+    // a single flipped character breaks the checksum
+    char hrp[100];
+    uint8_t data[100];
+    size_t data_len = 0;
+    ASSERT_EQ(bech32_decode(hrp, data, &data_len, "abcdef1qpzry9x8gf2tvdw0s3jn54khce6mua7lmqqqxx"),
+              BECH32_ENCODING_NONE);
+}
+std::string stream_encode(const char *hrp, const uint8_t *in, size_t in_len, uint8_t pad, bech32_encoding enc,
+                          size_t max_len, size_t chunk) {
+    bech32_stream_t ctx;
+    if (bech32_stream_init(&ctx, hrp, in, in_len, pad, enc, max_len) != zxerr_ok) return "";
+    std::string result;
+    std::vector<char> buf(chunk + 1);
+    size_t written = 0;
+    do {
+        EXPECT_EQ(bech32_stream_read(&ctx, buf.data(), buf.size(), &written), zxerr_ok);
+        EXPECT_EQ(buf[written], 0);
+        result.append(buf.data(), written);
+    } while (written > 0);
+    EXPECT_EQ(result.size(), ctx.total_len);
+    return result;
+}
+
+TEST(BECH32, stream_matches_encode) {
+    std::mt19937 rng(7);
+    char expected[256];
+    for (size_t len = 0; len <= 50; len++) {
+        std::vector<uint8_t> data(len + 1);
+        for (auto &b : data) b = rng() & 0xFF;
+        for (uint8_t pad = 0; pad < 2; pad++) {
+            for (auto enc : {BECH32_ENCODING_BECH32, BECH32_ENCODING_BECH32M}) {
+                const auto err = bech32EncodeFromBytes(expected, sizeof(expected), "zx", data.data(), len, pad, enc);
+                bech32_stream_t ctx;
+                const auto streamErr =
+                    bech32_stream_init(&ctx, "zx", data.data(), len, pad, enc, BECH32_MAX_LEN);
+                ASSERT_EQ(err == zxerr_ok, streamErr == zxerr_ok) << "len=" << len << " pad=" << (int)pad;
+                if (err != zxerr_ok) continue;
+
+                for (size_t chunk : {1, 3, 7, 16, 200}) {
+                    ASSERT_EQ(stream_encode("zx", data.data(), len, pad, enc, BECH32_MAX_LEN, chunk), expected);
+                }
+            }
+        }
+    }
+}
+
+TEST(BECH32, stream_long_form) {
+    // 300 bytes -> 480 symbols, far beyond the BIP173 limit
+    std::vector<uint8_t> data(300);
+    for (size_t i = 0; i < data.size(); i++) data[i] = (uint8_t)(i * 37 + 11);
+    const char *hrp = "uview";
+
+    bech32_stream_t ctx;
+    ASSERT_EQ(bech32_stream_init(&ctx, hrp, data.data(), data.size(), 1, BECH32_ENCODING_BECH32M, BECH32_MAX_LEN),
+              zxerr_out_of_bounds);
+    ASSERT_EQ(bech32_stream_init(&ctx, hrp, data.data(), data.size(), 1, BECH32_ENCODING_BECH32M, 1000), zxerr_ok);
+    ASSERT_EQ(ctx.total_len, strlen(hrp) + 1 + 480 + 6);
+
+    const std::string encoded = stream_encode(hrp, data.data(), data.size(), 1, BECH32_ENCODING_BECH32M, 1000, 33);
+    ASSERT_EQ(encoded.size(), ctx.total_len);
+
+    // data part matches convert_bits and the checksum verifies with the bitwise polymod
+    uint8_t symbols[600];
+    size_t symbols_len = 0;
+    ASSERT_EQ(convert_bits(symbols, &symbols_len, 5, data.data(), data.size(), 8, 1), 1);
+    std::vector<uint8_t> values;
+    for (const char *c = hrp; *c; c++) values.push_back(*c >> 5);
+    values.push_back(0);
+    for (const char *c = hrp; *c; c++) values.push_back(*c & 0x1F);
+    const char *charset = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
+    for (size_t i = strlen(hrp) + 1; i < encoded.size(); i++) {
+        const uint8_t v = strchr(charset, encoded[i]) - charset;
+        if (values.size() < 2 * strlen(hrp) + 1 + symbols_len) {
+            ASSERT_EQ(v, symbols[i - strlen(hrp) - 1]);
+        }
+        values.push_back(v);
+    }
+    ASSERT_EQ(reference_polymod(1, values.data(), values.size()), (uint32_t)BECH32M_CONST);
+}
+
+TEST(BECH32, stream_paged) {
+    std::vector<uint8_t> data(120);
+    for (size_t i = 0; i < data.size(); i++) data[i] = (uint8_t)(i * 13);
+    const std::string full = stream_encode("addr", data.data(), data.size(), 1, BECH32_ENCODING_BECH32, 500, 64);
+    ASSERT_FALSE(full.empty());
+
+    for (uint16_t outLen : {2, 17, 33, 100, 300}) {
+        char page[301];
+        uint8_t pageCount = 0;
+        char expectedPage[301];
+        uint8_t expectedCount = 0;
+        pageStringExt(expectedPage, outLen, full.c_str(), full.size(), 0, &expectedCount);
+
+        std::string joined;
+        for (uint8_t idx = 0; idx <= expectedCount; idx++) {
+            ASSERT_EQ(bech32EncodeFromBytesPaged(page, outLen, "addr", data.data(), data.size(), 1,
+                                                 BECH32_ENCODING_BECH32, 500, idx, &pageCount),
+                      zxerr_ok);
+            ASSERT_EQ(pageCount, expectedCount);
+            pageStringExt(expectedPage, outLen, full.c_str(), full.size(), idx, &expectedCount);
+            ASSERT_STREQ(page, expectedPage) << "outLen=" << outLen << " idx=" << (int)idx;
+            joined += page;
+        }
+        ASSERT_EQ(joined, full);
+    }
+}
+// Previous two-pass implementation: convert_bits into a stack array, then bech32_encode
+zxerr_t legacy_bech32_encode_from_bytes(char *out, size_t out_len, const char *hrp, const uint8_t *in, size_t in_len,
+                                        uint8_t pad, bech32_encoding enc) {
+    MEMZERO(out, out_len);
+    if (in_len > MAX_INPUT_SIZE) return zxerr_out_of_bounds;
+    if (out_len < strlen(hrp) + (in_len * 2) + 7) return zxerr_buffer_too_small;
+    uint8_t tmp_data[MAX_INPUT_SIZE * 2];
+    size_t tmp_size = 0;
+    if (!convert_bits(tmp_data, &tmp_size, 5, in, in_len, 8, pad)) return zxerr_encoding_failed;
+    if (tmp_size >= out_len) return zxerr_out_of_bounds;
+    if (!bech32_encode(out, hrp, tmp_data, tmp_size, enc)) return zxerr_encoding_failed;
+    return zxerr_ok;
+}
+
+TEST(BECH32, fused_matches_legacy) {
+    std::mt19937 rng(99);
+    const char *hrps[] = {"", "a", "zx", "bc", "addr_test", "Upper", "sp ace", "an83characterlonghumanreadablepart"};
+    char expected[256];
+    char actual[256];
+    for (size_t len = 0; len <= MAX_INPUT_SIZE + 1; len++) {
+        std::vector<uint8_t> data(len + 1);
+        for (auto &b : data) b = rng() & 0xFF;
+        // make the no-padding case valid for some inputs
+        if (len % 3 == 0) data[len - (len > 0)] &= 0xE0;
+        for (const auto &hrp : hrps) {
+            for (uint8_t pad = 0; pad < 2; pad++) {
+                for (auto enc : {BECH32_ENCODING_NONE, BECH32_ENCODING_BECH32, BECH32_ENCODING_BECH32M}) {
+                    const size_t out_len = (rng() % 2) ? sizeof(expected) : strlen(hrp) + len * 2 + 7;
+                    const auto e1 = legacy_bech32_encode_from_bytes(expected, out_len, hrp, data.data(), len, pad, enc);
+                    const auto e2 = bech32EncodeFromBytes(actual, out_len, hrp, data.data(), len, pad, enc);
+                    ASSERT_EQ(e1, e2) << "len=" << len << " hrp=" << hrp << " pad=" << (int)pad;
+                    ASSERT_EQ(memcmp(expected, actual, out_len), 0) << "len=" << len << " hrp=" << hrp;
+                }
+            }
+        }
+    }
+}
+
+TEST(BECH32, DISABLED_benchmark_fused_vs_legacy) {
+    const size_t iterations = 2000;
+    volatile size_t sink = 0;
+    char out[256];
+
+    std::cout << "len\tlegacy[ns]\tfused[ns]\tspeedup" << std::endl;
+    for (size_t len : {20, 32, 40, 50}) {
+        std::vector<uint8_t> data(len);
+        for (size_t i = 0; i < len; i++) data[i] = (uint8_t)(i * 29 + 3);
+
+        auto bench = [&](zxerr_t (*fn)(char *, size_t, const char *, const uint8_t *, size_t, uint8_t,
+                                       bech32_encoding)) {
+            return bench_ns(
+                [&]() { sink = sink + fn(out, sizeof(out), "bc", data.data(), len, 1, BECH32_ENCODING_BECH32); },
+                iterations);
+        };
+        const double legacy = bench(legacy_bech32_encode_from_bytes);
+        const double fused = bench(bech32EncodeFromBytes);
+        std::cout << len << "\t" << legacy << "\t\t" << fused << "\t\t" << legacy / fused << "x" << std::endl;
+    }
+}
+
 }  // namespace
@@ -17,6 +17,9 @@
 #include <zxformat.h>
 #include <zxmacros.h>
 
+#include <random>
+#include <string>
+
 namespace {
 TEST(MACROS, bip32empty) {
     char buffer[100];
@@ -86,4 +89,58 @@ TEST(MACROS, bip44path3) {
 
     EXPECT_EQ("44'/60/0/0/1'", std::string(buffer));
 }
+
+TEST(MACROS, bip32lenDeepPath) {
+    const uint32_t path[] = {0x8000002c, 0x8000003c, 0x80000000, 0, 1, 2, 0x7FFFFFFF, 0xFFFFFFFF, 10, 0x80000000};
+    char buffer[100];
+
+    const uint16_t len = bip32_to_str_len(buffer, sizeof(buffer), path, 10);
+    const std::string expected = "44'/60'/0'/0/1/2/2147483647/2147483647'/10/0'";
+    EXPECT_EQ(expected, std::string(buffer));
+    EXPECT_EQ(expected.size(), len);
+
+    // The legacy wrapper keeps its five component limit
+    bip32_to_str(buffer, sizeof(buffer), path, 10);
+    EXPECT_EQ("ERROR", std::string(buffer));
+}
+
+TEST(MACROS, bip32lenBufferLimits) {
+    const uint32_t path[] = {0x8000002c, 60, 0, 0, 1};
+    char buffer[20];
+
+    // "44'/60/0/0/1" is 12 characters plus the terminator
+    EXPECT_EQ(bip32_to_str_len(buffer, 13, path, 5), 12);
+    EXPECT_EQ("44'/60/0/0/1", std::string(buffer));
+    memset(buffer, 'x', sizeof(buffer));
+    EXPECT_EQ(bip32_to_str_len(buffer, 12, path, 5), 0);
+    EXPECT_EQ(std::string(12, '\0'), std::string(buffer, 12));
+    EXPECT_EQ(buffer[12], 'x');
+
+    EXPECT_EQ(bip32_to_str_len(buffer, sizeof(buffer), path, 0), 10);
+    EXPECT_EQ("EMPTY PATH", std::string(buffer));
+    EXPECT_EQ(bip32_to_str_len(buffer, 10, path, 0), 0);
+    EXPECT_EQ(bip32_to_str_len(buffer, sizeof(buffer), nullptr, 1), 0);
+}
+
+TEST(MACROS, bip32lenMatchesSnprintf) {
+    std::mt19937 rng(16);
+    uint32_t path[255];
+    char buffer[3000];
+
+    for (int iter = 0; iter < 2000; iter++) {
+        const uint8_t pathLen = static_cast<uint8_t>(1 + rng() % 255);
+        std::string expected;
+        for (uint8_t i = 0; i < pathLen; i++) {
+            // Mix small indices with full range ones
+            path[i] = (rng() % 2 == 0) ? rng() : (rng() % 100) | (rng() & 0x80000000u);
+            char component[16];
+            snprintf(component, sizeof(component), "%u%s%s", path[i] & 0x7FFFFFFFu,
+                     (path[i] & 0x80000000u) ? "'" : "", (i + 1 < pathLen) ? "/" : "");
+            expected += component;
+        }
+
+        ASSERT_EQ(bip32_to_str_len(buffer, sizeof(buffer), path, pathLen), expected.size());
+        ASSERT_EQ(expected, std::string(buffer));
+    }
+}
 }  // namespace
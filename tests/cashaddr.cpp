@@ -0,0 +1,98 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <cashaddr.h>
+#include <gmock/gmock.h>
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+const char *CHARSET = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
+
+// Bitwise polymod from the CashAddr specification
+uint64_t reference_polymod(uint64_t c, const uint8_t *values, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const uint8_t c0 = c >> 35;
+        c = ((c & 0x07ffffffff) << 5) ^ values[i];
+        if (c0 & 0x01) c ^= 0x98f2bc8e61;
+        if (c0 & 0x02) c ^= 0x79b76d99e2;
+        if (c0 & 0x04) c ^= 0xf33e5fb3c4;
+        if (c0 & 0x08) c ^= 0xae2eabe2a8;
+        if (c0 & 0x10) c ^= 0x1e4f43e470;
+    }
+    return c;
+}
+
+// Splits "prefix:payload" and maps the payload to 5-bit symbols
+void split_address(const std::string &addr, std::string &prefix, std::vector<uint8_t> &data) {
+    const size_t sep = addr.find(':');
+    prefix = addr.substr(0, sep);
+    data.clear();
+    for (size_t i = sep + 1; i < addr.size(); i++) {
+        data.push_back(strchr(CHARSET, addr[i]) - CHARSET);
+    }
+}
+
+TEST(CASHADDR, checksum_update_matches_reference) {
+    std::mt19937 rng(42);
+    for (size_t n = 0; n < 200; n++) {
+        std::vector<uint8_t> symbols(n);
+        for (auto &s : symbols) s = rng() & 0x1F;
+        const uint64_t start = (n == 0) ? 1 : (((uint64_t)rng() << 32 | rng()) & 0xFFFFFFFFFFull);
+        ASSERT_EQ(cashaddr_checksum_update(start, symbols.data(), n), reference_polymod(start, symbols.data(), n))
+            << "n=" << n;
+    }
+}
+
+TEST(CASHADDR, spec_vectors) {
+    const char *vectors[] = {
+        "prefix:x64nx6hz",
+        "p:gpf8m4h7",
+        "bitcoincash:qpzry9x8gf2tvdw0s3jn54khce6mua7lcw20ayyn",
+        "bchtest:testnetaddress4d6njnut",
+        "bchreg:555555555555555555555555555555555555555555555udxmlmrz",
+        "bitcoincash:qpm2qsznhks23z7629mms6s4cwef74vcwvy22gdx6a",
+        "bchtest:pr6m7j9njldwwzlg9v7v53unlr4jkmx6eyvwc0uz5t",
+    };
+
+    for (const auto &v : vectors) {
+        std::string prefix;
+        std::vector<uint8_t> data;
+        split_address(v, prefix, data);
+        ASSERT_EQ(cashaddr_verify_checksum(prefix.c_str(), data.data(), data.size()), zxerr_ok) << v;
+
+        uint8_t checksum[CASHADDR_CHECKSUM_SYMBOLS];
+        const size_t payloadLen = data.size() - CASHADDR_CHECKSUM_SYMBOLS;
+        ASSERT_EQ(cashaddr_create_checksum(checksum, sizeof(checksum), prefix.c_str(), data.data(), payloadLen),
+                  zxerr_ok);
+        ASSERT_EQ(memcmp(checksum, data.data() + payloadLen, sizeof(checksum)), 0) << v;
+
+        // any single symbol change is detected
+        data[0] ^= 1;
+        ASSERT_EQ(cashaddr_verify_checksum(prefix.c_str(), data.data(), data.size()), zxerr_encoding_failed) << v;
+    }
+}
+
+TEST(CASHADDR, invalid_inputs) {
+    uint8_t checksum[CASHADDR_CHECKSUM_SYMBOLS];
+    const uint8_t bad[] = {1, 2, 32};
+    ASSERT_EQ(cashaddr_create_checksum(checksum, sizeof(checksum), "p", bad, sizeof(bad)), zxerr_encoding_failed);
+    ASSERT_EQ(cashaddr_create_checksum(checksum, sizeof(checksum) - 1, "p", bad, 2), zxerr_buffer_too_small);
+    ASSERT_EQ(cashaddr_verify_checksum("p", bad, sizeof(bad)), zxerr_out_of_bounds);
+}
+}  // namespace
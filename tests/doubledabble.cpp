@@ -16,8 +16,15 @@
 
 #include <hexutils.h>
 
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
 #include "bignum.h"
 #include "gmock/gmock.h"
+#include "test_utils.h"
+#include "zxformat.h"
 
 using ::testing::TestWithParam;
 using ::testing::Values;
@@ -138,3 +145,214 @@ TEST(BignumBigEndianTests, range) {
         EXPECT_THAT(std::string(bufferUI), testing::Eq(expected.str())) << s.str();
     }
 }
+
+namespace {
+
+// Bit-serial double-dabble, kept as reference for differential tests and benchmarks
+void legacy_doubledabble(uint8_t *bcdOut, uint16_t bcdOutLen, const uint8_t *binValue, uint16_t binValueLen,
+                         bool bigEndian) {
+    MEMZERO(bcdOut, bcdOutLen);
+
+    for (uint32_t bitIdx = 0; bitIdx < binValueLen * 8u; bitIdx++) {
+        for (uint16_t j = 0; j < bcdOutLen; j++) {
+            uint16_t tmp = bcdOut[j];
+            if ((bcdOut[j] & 0x0Fu) > 0x04u) {
+                tmp += 0x03u;
+            }
+            if ((bcdOut[j] & 0xF0u) > 0x40u) {
+                tmp += 0x30u;
+            }
+            bcdOut[j] = (uint8_t)tmp;
+        }
+
+        const uint16_t byteIdx = bitIdx >> 3u;
+        const uint8_t mask = 0x80u >> (bitIdx & 0x7u);
+        uint8_t carry = bigEndian ? (uint8_t)((binValue[byteIdx] & mask) > 0)
+                                  : (uint8_t)((binValue[binValueLen - byteIdx - 1] & mask) > 0);
+
+        // Big-endian input fills the BCD least significant byte first, little-endian input the other way round
+        for (uint16_t j = 0; j < bcdOutLen; j++) {
+            const uint16_t idx = bigEndian ? j : (uint16_t)(bcdOutLen - j - 1);
+            const uint8_t carry2 = (uint8_t)(bcdOut[idx] > 127u);
+            bcdOut[idx] = (uint8_t)((bcdOut[idx] << 1u) + carry);
+            carry = carry2;
+        }
+    }
+}
+
+// BCD, print, insert the decimal point and trim, as apps did before bignum_to_fpstr
+std::string legacy_fpstr(const uint8_t *bytes, uint16_t len, uint8_t decimals, bool trim) {
+    uint8_t bcd[80];
+    char bignum[160];
+    char output[160];
+    legacy_doubledabble(bcd, sizeof(bcd), bytes, len, true);
+    if (!bignumBigEndian_bcdprint(bignum, sizeof(bignum), bcd, sizeof(bcd))) {
+        return "";
+    }
+    if (fpstr_to_str(output, sizeof(output), bignum, decimals)) {
+        return "";
+    }
+    if (trim) {
+        number_inplace_trimming(output, 1);
+    }
+    return output;
+}
+
+}  // namespace
+
+// Radix conversion must reproduce double-dabble byte for byte, including truncation of small BCD buffers
+// and the fallback for values longer than BIGNUM_DEC_MAX_INPUT_LEN
+TEST(BignumRadix, matches_doubledabble) {
+    std::mt19937 rng(13);
+
+    for (int iter = 0; iter < 3000; iter++) {
+        const size_t len = rng() % (BIGNUM_DEC_MAX_INPUT_LEN + 12);
+        auto value = random_bytes(rng, len);
+        // Leading zeros and short values exercise the limb trimming
+        for (size_t i = 0; i < len && rng() % 4 == 0; i++) {
+            value[i] = 0;
+        }
+        const uint16_t bcdLen = static_cast<uint16_t>(1 + rng() % 170);
+
+        for (const bool bigEndian : {true, false}) {
+            std::vector<uint8_t> input = value;
+            if (!bigEndian) {
+                std::reverse(input.begin(), input.end());
+            }
+            std::vector<uint8_t> expected(bcdLen);
+            std::vector<uint8_t> actual(bcdLen, 0xAA);
+            legacy_doubledabble(expected.data(), bcdLen, input.data(), static_cast<uint16_t>(len), bigEndian);
+            if (bigEndian) {
+                bignumBigEndian_to_bcd(actual.data(), bcdLen, input.data(), static_cast<uint16_t>(len));
+            } else {
+                bignumLittleEndian_to_bcd(actual.data(), bcdLen, input.data(), static_cast<uint16_t>(len));
+            }
+            ASSERT_EQ(expected, actual) << "len " << len << " bcdLen " << bcdLen << " bigEndian " << bigEndian;
+        }
+    }
+}
+
+TEST(BignumRadix, to_decimal) {
+    uint8_t in[100];
+    char out[200];
+
+    auto len = parseHexString(in, sizeof(in), "d20a3fce96f1cf8c9cb4378c37a4873f17621ebce404f5aa13");
+    ASSERT_TRUE(bignumBigEndian_to_decimal(out, sizeof(out), in, static_cast<uint16_t>(len)));
+    EXPECT_STREQ(out, "1318442675213289749221432902819395197389189473307425559128595");
+    ASSERT_TRUE(bignumLittleEndian_to_decimal(out, sizeof(out), in, static_cast<uint16_t>(len)));
+    EXPECT_STREQ(out, "123456789012345678901234567890123456789012345678901234567890");
+
+    // 2^256 - 1
+    MEMSET(in, 0xFF, 32);
+    ASSERT_TRUE(bignumBigEndian_to_decimal(out, sizeof(out), in, 32));
+    EXPECT_STREQ(out, "115792089237316195423570985008687907853269984665640564039457584007913129639935");
+
+    // Exact fit needs room for the terminator
+    ASSERT_TRUE(bignumBigEndian_to_decimal(out, 79, in, 32));
+    EXPECT_FALSE(bignumBigEndian_to_decimal(out, 78, in, 32));
+    EXPECT_EQ(out[0], 0);
+
+    // Chunk boundaries: 10^9 and 10^19
+    len = parseHexString(in, sizeof(in), "3b9aca00");
+    ASSERT_TRUE(bignumBigEndian_to_decimal(out, sizeof(out), in, static_cast<uint16_t>(len)));
+    EXPECT_STREQ(out, "1000000000");
+    len = parseHexString(in, sizeof(in), "8ac7230489e80000");
+    ASSERT_TRUE(bignumBigEndian_to_decimal(out, sizeof(out), in, static_cast<uint16_t>(len)));
+    EXPECT_STREQ(out, "10000000000000000000");
+
+    // Zero, empty input and leading zeros beyond the limit
+    MEMZERO(in, sizeof(in));
+    ASSERT_TRUE(bignumBigEndian_to_decimal(out, 2, in, 0));
+    EXPECT_STREQ(out, "0");
+    in[sizeof(in) - 1] = 7;
+    ASSERT_TRUE(bignumBigEndian_to_decimal(out, sizeof(out), in, sizeof(in)));
+    EXPECT_STREQ(out, "7");
+    EXPECT_FALSE(bignumBigEndian_to_decimal(out, 1, in, sizeof(in)));
+
+    // Too long after trimming
+    MEMSET(in, 0x01, sizeof(in));
+    EXPECT_FALSE(bignumBigEndian_to_decimal(out, sizeof(out), in, BIGNUM_DEC_MAX_INPUT_LEN + 1));
+}
+
+TEST(BignumRadix, DISABLED_benchmark_vs_doubledabble) {
+    std::mt19937 rng(64);
+    const size_t iterations = 500;
+    volatile uint8_t sink = 0;
+
+    std::cout << "len\tdouble-dabble[ns]\tradix[ns]\tspeedup" << std::endl;
+    for (const size_t len : {8, 16, 32, 64}) {
+        const auto value = random_bytes(rng, len);
+        uint8_t bcd[80];
+
+        const double legacy = bench_ns(
+            [&]() {
+                legacy_doubledabble(bcd, sizeof(bcd), value.data(), static_cast<uint16_t>(len), true);
+                sink = sink + bcd[0];
+            },
+            iterations);
+        const double radix = bench_ns(
+            [&]() {
+                bignumBigEndian_to_bcd(bcd, sizeof(bcd), value.data(), static_cast<uint16_t>(len));
+                sink = sink + bcd[0];
+            },
+            iterations);
+
+        std::cout << len << "\t" << legacy << "\t\t" << radix << "\t\t" << legacy / radix << std::endl;
+    }
+}
+
+TEST(BignumRadix, fpstr) {
+    uint8_t in[40];
+    char out[100];
+
+    auto len = parseHexString(in, sizeof(in), "0de0b6b3a7640000");  // 10^18
+    EXPECT_EQ(bignum_to_fpstr(out, sizeof(out), in, static_cast<uint16_t>(len), 18, bool_true), 3);
+    EXPECT_STREQ(out, "1.0");
+    EXPECT_EQ(bignum_to_fpstr(out, sizeof(out), in, static_cast<uint16_t>(len), 18, bool_false), 20);
+    EXPECT_STREQ(out, "1.000000000000000000");
+    EXPECT_EQ(bignum_to_fpstr(out, sizeof(out), in, static_cast<uint16_t>(len), 20, bool_true), 4);
+    EXPECT_STREQ(out, "0.01");
+    EXPECT_EQ(bignum_to_fpstr(out, sizeof(out), in, static_cast<uint16_t>(len), 0, bool_true), 19);
+    EXPECT_STREQ(out, "1000000000000000000");
+
+    len = parseHexString(in, sizeof(in), "3039");  // 12345
+    EXPECT_EQ(bignum_to_fpstr(out, sizeof(out), in, static_cast<uint16_t>(len), 2, bool_true), 6);
+    EXPECT_STREQ(out, "123.45");
+    EXPECT_EQ(bignum_to_fpstr(out, sizeof(out), in, static_cast<uint16_t>(len), 5, bool_true), 7);
+    EXPECT_STREQ(out, "0.12345");
+
+    EXPECT_EQ(bignum_to_fpstr(out, sizeof(out), in, 0, 3, bool_true), 3);
+    EXPECT_STREQ(out, "0.0");
+    EXPECT_EQ(bignum_to_fpstr(out, sizeof(out), in, 0, 3, bool_false), 5);
+    EXPECT_STREQ(out, "0.000");
+
+    // "123.45" needs 7 bytes with the terminator
+    EXPECT_EQ(bignum_to_fpstr(out, 7, in, 2, 2, bool_true), 6);
+    EXPECT_EQ(bignum_to_fpstr(out, 6, in, 2, 2, bool_true), 0);
+    EXPECT_EQ(out[0], 0);
+}
+
+TEST(BignumRadix, fpstr_matches_legacy_chain) {
+    std::mt19937 rng(14);
+
+    for (int iter = 0; iter < 5000; iter++) {
+        const size_t len = rng() % 33;
+        auto value = random_bytes(rng, len);
+        // Values with many trailing decimal zeros
+        if (len > 0 && rng() % 3 == 0) {
+            value[len - 1] = 0;
+            for (size_t i = 0; i + 1 < len && rng() % 2 == 0; i++) {
+                value[i] = 0;
+            }
+        }
+        const uint8_t decimals = static_cast<uint8_t>(rng() % 90);
+        const bool trim = rng() % 2 == 0;
+
+        const std::string expected = legacy_fpstr(value.data(), static_cast<uint16_t>(len), decimals, trim);
+        char out[160];
+        const uint16_t outLen = bignum_to_fpstr(out, sizeof(out), value.data(), static_cast<uint16_t>(len), decimals,
+                                                trim ? bool_true : bool_false);
+        ASSERT_EQ(outLen, expected.size());
+        ASSERT_EQ(std::string(out), expected) << "len " << len << " decimals " << int(decimals);
+    }
+}
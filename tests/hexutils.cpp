@@ -16,9 +16,14 @@
 
 #include "hexutils.h"
 
+#include <cctype>
+#include <cstring>
+#include <random>
 #include <string>
+#include <vector>
 
 #include "gmock/gmock.h"
+#include "zxformat.h"
 
 TEST(HEXUTILS, parseHexString) {
     char s[] = "1234567890";
@@ -49,3 +54,59 @@ TEST(HEXUTILS, parseHexString2) {
     ASSERT_THAT(data[3], testing::Eq(0xe7));
     ASSERT_THAT(data[4], testing::Eq(0xee));
 }
+
+namespace {
+// Previous libc-based implementation
+size_t legacy_parse_hex(uint8_t *out, size_t outLen, const char *input, size_t len) {
+    if ((len / 2) > outLen || len % 2 == 1) return 0;
+    for (size_t i = 0; i < len; i++) {
+        if (!isxdigit((unsigned char)input[i])) return 0;
+    }
+    for (size_t i = 0; i < len; i += 2) {
+        auto nib = [](char c) -> uint8_t { return isdigit((unsigned char)c) ? c - '0' : tolower(c) - 'a' + 10; };
+        out[i / 2] = (nib(input[i]) << 4) | nib(input[i + 1]);
+    }
+    return len / 2;
+}
+}  // namespace
+
+TEST(HEXUTILS, parseHexStringExt_matches_legacy) {
+    std::mt19937 rng(3);
+    const char valid[] = "0123456789abcdefABCDEF";
+
+    for (size_t len = 0; len <= 70; len++) {
+        std::string s(len, '0');
+        for (auto &c : s) c = valid[rng() % (sizeof(valid) - 1)];
+
+        uint8_t expected[40];
+        uint8_t actual[40];
+        const size_t e = legacy_parse_hex(expected, sizeof(expected), s.data(), len);
+        ASSERT_EQ(parseHexStringExt(actual, sizeof(actual), s.data(), len), e) << s;
+        ASSERT_EQ(memcmp(expected, actual, e), 0) << s;
+
+        // every byte value that is not a hex digit is rejected at every position
+        for (size_t pos = 0; pos < len; pos++) {
+            std::string bad = s;
+            for (int c = 0; c < 256; c++) {
+                if (isxdigit(c)) continue;
+                bad[pos] = (char)c;
+                ASSERT_EQ(parseHexStringExt(actual, sizeof(actual), bad.data(), len), 0u) << pos << " " << c;
+            }
+        }
+    }
+}
+
+TEST(HEXUTILS, parseHexStringExt_bounds) {
+    uint8_t out[4];
+    EXPECT_EQ(parseHexStringExt(out, sizeof(out), "0011223344", 10), 0u);
+    EXPECT_EQ(parseHexStringExt(out, sizeof(out), "00112233", 8), 4u);
+    EXPECT_EQ(parseHexStringExt(out, sizeof(out), "0011223", 7), 0u);
+    // only inputLen characters are read, no terminator is needed
+    EXPECT_EQ(parseHexStringExt(out, sizeof(out), "a1b2zz", 4), 2u);
+    EXPECT_EQ(out[0], 0xa1);
+    EXPECT_EQ(out[1], 0xb2);
+
+    uint8_t data[8];
+    EXPECT_EQ(hexstr_to_array(data, sizeof(data), "12zz", 4), 0u);
+    for (auto b : data) EXPECT_EQ(b, 0);
+}
@@ -0,0 +1,158 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <bittools.h>
+#include <gmock/gmock.h>
+#include <hexutils.h>
+#include <segwit_addr.h>
+#include <zxmacros.h>
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+// Previous implementation: copies hrp and data out of the address, then converts the program
+int legacy_segwit_addr_decode(int *witver, uint8_t *witdata, size_t *witdata_len, const char *hrp, const char *addr) {
+    uint8_t data[84];
+    char hrp_actual[84];
+    size_t data_len;
+    bech32_encoding enc = bech32_decode(hrp_actual, data, &data_len, addr);
+    if (enc == BECH32_ENCODING_NONE) return 0;
+    if (data_len == 0 || data_len > 65) return 0;
+    if (strncmp(hrp, hrp_actual, 84) != 0) return 0;
+    if (data[0] > 16) return 0;
+    if (data[0] == 0 && enc != BECH32_ENCODING_BECH32) return 0;
+    if (data[0] > 0 && enc != BECH32_ENCODING_BECH32M) return 0;
+    *witdata_len = 0;
+    if (!convert_bits(witdata, witdata_len, 8, data + 1, data_len - 1, 5, 0)) return 0;
+    if (*witdata_len < 2 || *witdata_len > 40) return 0;
+    if (data[0] == 0 && *witdata_len != 20 && *witdata_len != 32) return 0;
+    *witver = data[0];
+    return 1;
+}
+
+typedef struct {
+    const char *address;
+    const char *hrp;
+    int version;
+    const char *program;
+} segwit_testcase_t;
+
+// BIP350 valid segwit addresses
+const segwit_testcase_t valid_addresses[] = {
+    {"BC1QW508D6QEJXTDG4Y5R3ZARVARY0C5XW7KV8F3T4", "bc", 0, "751e76e8199196d454941c45d1b3a323f1433bd6"},
+    {"tb1qrp33g0q5c5txsp9arysrx4k6zdkfs4nce4xj0gdcccefvpysxf3q0sl5k7", "tb", 0,
+     "1863143c14c5166804bd19203356da136c985678cd4d27a1b8c6329604903262"},
+    {"bc1pw508d6qejxtdg4y5r3zarvary0c5xw7kw508d6qejxtdg4y5r3zarvary0c5xw7kt5nd6y", "bc", 1,
+     "751e76e8199196d454941c45d1b3a323f1433bd6751e76e8199196d454941c45d1b3a323f1433bd6"},
+    {"BC1SW50QGDZ25J", "bc", 16, "751e"},
+    {"bc1zw508d6qejxtdg4y5r3zarvaryvaxxpcs", "bc", 2, "751e76e8199196d454941c45d1b3a323"},
+    {"tb1qqqqqp399et2xygdj5xreqhjjvcmzhxw4aywxecjdzew6hylgvsesrxh6hy", "tb", 0,
+     "000000c4a5cad46221b2a187905e5266362b99d5e91c6ce24d165dab93e86433"},
+    {"tb1pqqqqp399et2xygdj5xreqhjjvcmzhxw4aywxecjdzew6hylgvsesf3hn0c", "tb", 1,
+     "000000c4a5cad46221b2a187905e5266362b99d5e91c6ce24d165dab93e86433"},
+    {"bc1p0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7vqzk5jj0", "bc", 1,
+     "79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"},
+};
+
+// BIP350 invalid segwit addresses
+const char *invalid_addresses[] = {
+    "tc1p0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7vq5zuyut",
+    "bc1p0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7vqh2y7hd",
+    "tb1z0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7vqglt7rf",
+    "BC1S0XLXVLHEMJA6C4DQV22UAPCTQUPFHLXM9H8Z3K2E72Q4K9HCZ7VQ54WELL",
+    "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kemeawh",
+    "tb1q0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7vq24jc47",
+    "bc1p38j9r5y49hruaue7wxjce0updqjuyyx0kh56v8s25huc6995vvpql3jow4",
+    "BC130XLXVLHEMJA6C4DQV22UAPCTQUPFHLXM9H8Z3K2E72Q4K9HCZ7VQ7ZWS8R",
+    "bc1pw5dgrnzv",
+    "bc1p0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7v8n0nx0muaewav253zgeav",
+    "BC1QR508D6QEJXTDG4Y5R3ZARVARYV98GJ9P",
+    "tb1p0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7vq47Zagq",
+    "bc1p0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7v07qwwzcrf",
+    "tb1p0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7vpggkg4j",
+    "bc1gmk9yu",
+};
+
+TEST(SEGWIT, decode_valid_addresses) {
+    for (const auto &tc : valid_addresses) {
+        int version = -1;
+        uint8_t program[40];
+        size_t program_len = 0;
+        ASSERT_EQ(segwit_addr_decode(&version, program, &program_len, tc.hrp, tc.address), 1) << tc.address;
+        ASSERT_EQ(version, tc.version);
+
+        uint8_t expected[40];
+        const size_t expected_len = parseHexString(expected, sizeof(expected), tc.program);
+        ASSERT_EQ(program_len, expected_len);
+        ASSERT_EQ(memcmp(program, expected, expected_len), 0);
+
+        // encoding the program again gives the lowercase address
+        char encoded[100];
+        ASSERT_EQ(segwit_addr_encode(encoded, tc.hrp, version, program, program_len), 1);
+        std::string lower(tc.address);
+        for (auto &c : lower) c = tolower(c);
+        ASSERT_EQ(lower, encoded);
+
+        // a different expected hrp is rejected
+        ASSERT_EQ(segwit_addr_decode(&version, program, &program_len, "xx", tc.address), 0);
+    }
+}
+
+TEST(SEGWIT, decode_invalid_addresses) {
+    for (const auto &addr : invalid_addresses) {
+        for (const char *hrp : {"bc", "tb"}) {
+            int version = -1;
+            uint8_t program[40];
+            size_t program_len = 0;
+            ASSERT_EQ(segwit_addr_decode(&version, program, &program_len, hrp, addr), 0) << addr;
+        }
+    }
+}
+
+TEST(SEGWIT, decode_matches_legacy) {
+    std::mt19937 rng(2024);
+    const char alphabet[] = "qpzry9x8gf2tvdw0s3jn54khce6mua7lQPZRY9X8GF2TVDW0S3JN54KHCE6MUA7L1bio ~";
+
+    for (size_t iter = 0; iter < 20000; iter++) {
+        std::string addr = valid_addresses[rng() % array_length(valid_addresses)].address;
+        if (iter % 3 != 0) {
+            addr[rng() % addr.size()] = alphabet[rng() % (sizeof(alphabet) - 1)];
+        }
+        if (iter % 5 == 0) {
+            addr.erase(rng() % addr.size(), 1);
+        }
+        if (iter % 7 == 0) {
+            addr.insert(rng() % addr.size(), 1, alphabet[rng() % (sizeof(alphabet) - 1)]);
+        }
+
+        for (const char *hrp : {"bc", "tb", "BC", "b"}) {
+            int v1 = -1, v2 = -1;
+            uint8_t p1[40], p2[40];
+            size_t l1 = 0, l2 = 0;
+            const int r1 = legacy_segwit_addr_decode(&v1, p1, &l1, hrp, addr.c_str());
+            const int r2 = segwit_addr_decode(&v2, p2, &l2, hrp, addr.c_str());
+            ASSERT_EQ(r1, r2) << addr << " hrp=" << hrp;
+            if (r1) {
+                ASSERT_EQ(v1, v2);
+                ASSERT_EQ(l1, l2);
+                ASSERT_EQ(memcmp(p1, p2, l1), 0);
+            }
+        }
+    }
+}
+}  // namespace
@@ -0,0 +1,44 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+// Helpers shared by the differential tests and the benchmarks. Benchmarks are registered as DISABLED_ so the
+// suite stays quiet and deterministic; run them with
+//     zxlib_tests --gtest_also_run_disabled_tests --gtest_filter='*benchmark*'
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+inline std::vector<uint8_t> random_bytes(std::mt19937 &rng, size_t len) {
+    std::vector<uint8_t> data(len);
+    for (auto &b : data) {
+        b = static_cast<uint8_t>(rng());
+    }
+    return data;
+}
+
+// Average time of one call to f over iterations calls, in nanoseconds
+template <typename F>
+double bench_ns(F f, size_t iterations) {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        f();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+}
@@ -0,0 +1,281 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <gmock/gmock.h>
+
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "test_utils.h"
+#include "timeutils.h"
+
+namespace {
+
+bool is_leap(int64_t year) { return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0); }
+
+uint8_t month_days(int64_t year, uint8_t month) {
+    static const uint8_t days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return (uint8_t)(days[month - 1] + (month == 2 && is_leap(year) ? 1 : 0));
+}
+
+// Previous implementation: a table with the first day of every year from 1970 to 2600 (as generated by the
+// former scripts/yearLookup.py), searched linearly, then a walk over the months
+std::vector<uint32_t> legacy_year_lookup() {
+    std::vector<uint32_t> table;
+    uint32_t days = 0;
+    for (int64_t year = 1970; year <= 2600; year++) {
+        table.push_back(days);
+        days += is_leap(year) ? 366 : 365;
+    }
+    return table;
+}
+
+zxerr_t legacy_extractTime(const std::vector<uint32_t> &yearLookup, uint64_t time, timedata_t *date) {
+    memset(date, 0, sizeof(timedata_t));
+    date->tm_sec = (uint8_t)(time % 60);
+    time /= 60;
+    date->tm_min = (uint8_t)(time % 60);
+    time /= 60;
+    date->tm_hour = (uint8_t)(time % 24);
+    time /= 24;
+
+    while (date->tm_year < yearLookup.size() && yearLookup[date->tm_year] <= time) {
+        date->tm_year++;
+    }
+    if (date->tm_year == 0 || date->tm_year == yearLookup.size()) {
+        return zxerr_out_of_bounds;
+    }
+    date->tm_year--;
+    date->tm_day = (uint16_t)(time - yearLookup[date->tm_year] + 1);
+    date->tm_year = (uint16_t)(1970 + date->tm_year);
+
+    for (date->tm_mon = 1; date->tm_day > month_days(date->tm_year, date->tm_mon); date->tm_mon++) {
+        date->tm_day -= month_days(date->tm_year, date->tm_mon);
+    }
+    date->monthName = getMonth(date->tm_mon);
+    return zxerr_ok;
+}
+
+void expect_same(const timedata_t &a, const timedata_t &b, int64_t t) {
+    ASSERT_EQ(a.tm_year, b.tm_year) << t;
+    ASSERT_EQ(a.tm_mon, b.tm_mon) << t;
+    ASSERT_EQ(a.tm_day, b.tm_day) << t;
+    ASSERT_EQ(a.tm_hour, b.tm_hour) << t;
+    ASSERT_EQ(a.tm_min, b.tm_min) << t;
+    ASSERT_EQ(a.tm_sec, b.tm_sec) << t;
+    ASSERT_STREQ(a.monthName, b.monthName) << t;
+}
+
+TEST(TIMEUTILS, matches_year_table_every_day) {
+    const std::vector<uint32_t> table = legacy_year_lookup();
+    const uint32_t lastDay = table.back();
+    for (uint64_t day = 0; day < lastDay; day++) {
+        // A different time of day for every date
+        const uint64_t t = day * 86400 + (day * 7919) % 86400;
+        timedata_t expected, actual;
+        ASSERT_EQ(legacy_extractTime(table, t, &expected), zxerr_ok);
+        ASSERT_EQ(extractTime(t, &actual), zxerr_ok);
+        expect_same(expected, actual, (int64_t)t);
+    }
+
+    // The table stopped at 2600, the closed form does not
+    timedata_t date;
+    EXPECT_EQ(legacy_extractTime(table, (uint64_t)lastDay * 86400, &date), zxerr_out_of_bounds);
+    ASSERT_EQ(extractTime((uint64_t)lastDay * 86400, &date), zxerr_ok);
+    EXPECT_EQ(date.tm_year, 2600);
+    EXPECT_EQ(date.tm_mon, 1);
+    EXPECT_EQ(date.tm_day, 1);
+}
+
+TEST(TIMEUTILS, full_range_by_walking_days) {
+    // Walk the calendar one day at a time from 0000-01-01 to 9999-12-31
+    int64_t year = 0;
+    uint8_t month = 1, day = 1;
+    for (int64_t days = -719528; days <= 2932896; days++) {
+        timedata_t date;
+        const int64_t t = days * 86400 + 86399;
+        ASSERT_EQ(extractTimeSigned(t, &date), zxerr_ok) << days;
+        ASSERT_EQ(date.tm_year, year) << days;
+        ASSERT_EQ(date.tm_mon, month) << days;
+        ASSERT_EQ(date.tm_day, day) << days;
+        ASSERT_EQ(date.tm_hour, 23);
+
+        if (++day > month_days(year, month)) {
+            day = 1;
+            if (++month > 12) {
+                month = 1;
+                year++;
+            }
+        }
+    }
+    EXPECT_EQ(year, 10000);
+}
+
+TEST(TIMEUTILS, signed_and_bounds) {
+    timedata_t date;
+    ASSERT_EQ(extractTimeSigned(-1, &date), zxerr_ok);
+    EXPECT_EQ(date.tm_year, 1969);
+    EXPECT_EQ(date.tm_mon, 12);
+    EXPECT_EQ(date.tm_day, 31);
+    EXPECT_EQ(date.tm_hour, 23);
+    EXPECT_EQ(date.tm_min, 59);
+    EXPECT_EQ(date.tm_sec, 59);
+    EXPECT_STREQ(date.monthName, "Dec");
+
+    // 1900 is not a leap year, 2000 is
+    ASSERT_EQ(extractTimeSigned(-2208988800 + 59 * 86400, &date), zxerr_ok);
+    EXPECT_EQ(date.tm_mon, 3);
+    EXPECT_EQ(date.tm_day, 1);
+    ASSERT_EQ(extractTime(951782400, &date), zxerr_ok);
+    EXPECT_EQ(date.tm_mon, 2);
+    EXPECT_EQ(date.tm_day, 29);
+
+    EXPECT_EQ(extractTimeSigned(-62167219200, &date), zxerr_ok);
+    EXPECT_EQ(extractTimeSigned(-62167219201, &date), zxerr_out_of_bounds);
+    EXPECT_EQ(extractTimeSigned(253402300799, &date), zxerr_ok);
+    EXPECT_EQ(extractTimeSigned(253402300800, &date), zxerr_out_of_bounds);
+    EXPECT_EQ(extractTimeSigned(INT64_MIN, &date), zxerr_out_of_bounds);
+    EXPECT_EQ(extractTime(UINT64_MAX, &date), zxerr_out_of_bounds);
+    EXPECT_EQ(extractTime(0, nullptr), zxerr_no_data);
+
+    char out[32];
+    ASSERT_EQ(printTime(out, sizeof(out), 253402300799), zxerr_ok);
+    EXPECT_STREQ(out, "31Dec9999 23:59:59UTC");
+}
+
+TEST(TIMEUTILS, DISABLED_benchmark_vs_year_table) {
+    const std::vector<uint32_t> table = legacy_year_lookup();
+    const size_t iterations = 200000;
+    volatile uint32_t sink = 0;
+
+    // Dates from `from`, `step` seconds apart
+    auto bench = [&](const std::function<uint32_t(uint64_t)> &fn, uint64_t from, uint64_t step) {
+        uint64_t t = from;
+        return bench_ns(
+            [&]() {
+                sink = sink + fn(t);
+                t += step;
+            },
+            iterations);
+    };
+    auto legacy = [&](uint64_t t) {
+        timedata_t date;
+        legacy_extractTime(table, t, &date);
+        return (uint32_t)date.tm_day;
+    };
+    auto closed = [&](uint64_t t) {
+        timedata_t date;
+        extractTime(t, &date);
+        return (uint32_t)date.tm_day;
+    };
+
+    std::cout << "dates\t\ttable[ns]\tcivil_from_days[ns]" << std::endl;
+    std::cout << "2023-2024\t" << bench(legacy, 1672531200, 97) << "\t\t" << bench(closed, 1672531200, 97)
+              << std::endl;
+    std::cout << "1970-2599\t" << bench(legacy, 0, 99436) << "\t\t" << bench(closed, 0, 99436) << std::endl;
+}
+
+// What apps hand-roll today on top of extractTime
+std::string reference_rfc3339(int64_t seconds, uint32_t nanos, uint8_t precision, int16_t offset, bool trim) {
+    timedata_t date;
+    if (extractTimeSigned(seconds + offset * 60, &date) != zxerr_ok) {
+        return "";
+    }
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%04d-%02d-%02dT%02d:%02d:%02d", date.tm_year, date.tm_mon, date.tm_day, date.tm_hour,
+             date.tm_min, date.tm_sec);
+    std::string s = buf;
+    if (precision > 0) {
+        snprintf(buf, sizeof(buf), "%09u", nanos);
+        std::string fraction(buf, precision);
+        if (trim) {
+            fraction.erase(fraction.find_last_not_of('0') + 1);
+        }
+        if (!fraction.empty()) {
+            s += "." + fraction;
+        }
+    }
+    if (offset == 0) {
+        s += "Z";
+    } else {
+        snprintf(buf, sizeof(buf), "%c%02d:%02d", offset < 0 ? '-' : '+', std::abs(offset) / 60, std::abs(offset) % 60);
+        s += buf;
+    }
+    return s;
+}
+
+TEST(TIMEUTILS, rfc3339_known_values) {
+    char out[RFC3339_MAX_LEN + 1];
+    EXPECT_EQ(printTimeRFC3339(out, sizeof(out), 0, 0, 0, 0, bool_false), 20u);
+    EXPECT_STREQ(out, "1970-01-01T00:00:00Z");
+
+    EXPECT_EQ(printTimeRFC3339(out, sizeof(out), 1710000307, 120000000, 9, 0, bool_false), 30u);
+    EXPECT_STREQ(out, "2024-03-09T16:05:07.120000000Z");
+    EXPECT_EQ(printTimeRFC3339(out, sizeof(out), 1710000307, 120000000, 9, 0, bool_true), 23u);
+    EXPECT_STREQ(out, "2024-03-09T16:05:07.12Z");
+    EXPECT_EQ(printTimeRFC3339(out, sizeof(out), 1710000307, 120000000, 3, 120, bool_false), 29u);
+    EXPECT_STREQ(out, "2024-03-09T18:05:07.120+02:00");
+    EXPECT_EQ(printTimeRFC3339(out, sizeof(out), 1710000307, 999999, 3, -330, bool_true), 25u);
+    EXPECT_STREQ(out, "2024-03-09T10:35:07-05:30");
+
+    // Nanoseconds are truncated, not rounded
+    EXPECT_GT(printTimeRFC3339(out, sizeof(out), -1, 999999999, 6, 0, bool_false), 0u);
+    EXPECT_STREQ(out, "1969-12-31T23:59:59.999999Z");
+
+    // Longest output and exact buffer fit
+    EXPECT_EQ(printTimeRFC3339(out, sizeof(out), 253402300799 - 60, 123456789, 9, -1439, bool_false),
+              (size_t)RFC3339_MAX_LEN);
+    EXPECT_STREQ(out, "9999-12-30T23:59:59.123456789-23:59");
+    EXPECT_EQ(printTimeRFC3339(out, RFC3339_MAX_LEN, 253402300799 - 60, 123456789, 9, -1439, bool_false), 0u);
+    EXPECT_STREQ(out, "");
+
+    // Invalid arguments and out of range local times
+    EXPECT_EQ(printTimeRFC3339(out, sizeof(out), 0, 1000000000, 9, 0, bool_false), 0u);
+    EXPECT_EQ(printTimeRFC3339(out, sizeof(out), 0, 0, 10, 0, bool_false), 0u);
+    EXPECT_EQ(printTimeRFC3339(out, sizeof(out), 0, 0, 0, 1440, bool_false), 0u);
+    EXPECT_EQ(printTimeRFC3339(out, sizeof(out), 253402300799, 0, 0, 1, bool_false), 0u);
+    EXPECT_EQ(printTimeRFC3339(out, sizeof(out), INT64_MAX, 0, 0, 0, bool_false), 0u);
+    EXPECT_EQ(printTimeRFC3339(out, sizeof(out), INT64_MIN, 0, 0, -60, bool_false), 0u);
+    EXPECT_EQ(printTimeRFC3339(nullptr, sizeof(out), 0, 0, 0, 0, bool_false), 0u);
+}
+
+TEST(TIMEUTILS, rfc3339_matches_reference) {
+    std::mt19937_64 rng(3339);
+    std::uniform_int_distribution<int64_t> secondsDist(-62167219200 - 86400, 253402300799 + 86400);
+    std::uniform_int_distribution<int> offsetDist(-RFC3339_MAX_TZ_OFFSET_MINUTES, RFC3339_MAX_TZ_OFFSET_MINUTES);
+    const uint32_t nanosSamples[] = {0, 1, 10, 500000000, 120000000, 999999999, 100, 123456789};
+
+    char out[RFC3339_MAX_LEN + 1];
+    for (int i = 0; i < 200000; i++) {
+        const int64_t seconds = secondsDist(rng);
+        const uint32_t nanos = (i & 1) ? (uint32_t)(rng() % 1000000000u) : nanosSamples[(i >> 1) % 8];
+        const uint8_t precision = (uint8_t)(i % 10);
+        const int16_t offset = (i % 3 == 0) ? 0 : (int16_t)offsetDist(rng);
+        const bool trim = (i & 2) != 0;
+
+        const std::string expected = reference_rfc3339(seconds, nanos, precision, offset, trim);
+        const size_t len =
+            printTimeRFC3339(out, sizeof(out), seconds, nanos, precision, offset, trim ? bool_true : bool_false);
+        ASSERT_EQ(len, expected.size()) << seconds << " " << nanos << " " << (int)precision << " " << offset;
+        ASSERT_EQ(std::string(out), expected) << seconds;
+    }
+}
+
+}  // namespace
@@ -0,0 +1,193 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <gmock/gmock.h>
+
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "test_utils.h"
+#include "utf8.h"
+
+namespace {
+
+// Byte at a time implementations the fast paths replace
+const char *legacy_utf8nvalid(const char *str, size_t n) {
+    const char *t = str;
+    size_t consumed = 0, remained = 0;
+    while ((void)(consumed = (size_t)(str - t)), consumed < n && '\0' != *str) {
+        remained = n - consumed;
+        if (0xf0 == (0xf8 & *str)) {
+            if (remained < 4) return str;
+            if ((0x80 != (0xc0 & str[1])) || (0x80 != (0xc0 & str[2])) || (0x80 != (0xc0 & str[3]))) return str;
+            if (0x80 == (0xc0 & str[4])) return str;
+            if ((0 == (0x07 & str[0])) && (0 == (0x30 & str[1]))) return str;
+            str += 4;
+        } else if (0xe0 == (0xf0 & *str)) {
+            if (remained < 3) return str;
+            if ((0x80 != (0xc0 & str[1])) || (0x80 != (0xc0 & str[2]))) return str;
+            if (0x80 == (0xc0 & str[3])) return str;
+            if ((0 == (0x0f & str[0])) && (0 == (0x20 & str[1]))) return str;
+            str += 3;
+        } else if (0xc0 == (0xe0 & *str)) {
+            if (remained < 2) return str;
+            if (0x80 != (0xc0 & str[1])) return str;
+            if (0x80 == (0xc0 & str[2])) return str;
+            if (0 == (0x1e & str[0])) return str;
+            str += 2;
+        } else if (0x00 == (0x80 & *str)) {
+            str += 1;
+        } else {
+            return str;
+        }
+    }
+    return nullptr;
+}
+
+// The byte at a time loop, stopped at the terminator instead of stepping past it when the last code point is
+// truncated
+size_t legacy_utf8nlen(const char *str, size_t n) {
+    const char *t = str;
+    const size_t limit = strnlen(str, n);
+    size_t length = 0;
+    while ((size_t)(str - t) < n && (size_t)(str - t) <= limit && '\0' != *str) {
+        if (0xf0 == (0xf8 & *str)) {
+            str += 4;
+        } else if (0xe0 == (0xf0 & *str)) {
+            str += 3;
+        } else if (0xc0 == (0xe0 & *str)) {
+            str += 2;
+        } else {
+            str += 1;
+        }
+        length++;
+    }
+    if ((size_t)(str - t) > n) {
+        length--;
+    }
+    return length;
+}
+
+std::string random_text(std::mt19937 &rng, size_t pieces, unsigned asciiPercent) {
+    const std::string valid[] = {"\xC3\xB1", "\xD0\x96", "\xE5\x93\x88", "\xE2\x82\xAC", "\xF0\x9F\x98\x80",
+                                 "\xED\xA0\x80", "\xF4\x90\x80\x80"};
+    const std::string invalid[] = {"\xC0\xAF", "\xC1\xBF", "\xE0\x80\xAF", "\xE0\x9F\xBF", "\xF0\x80\x80\xAF",
+                                   "\xF0\x8F\xBF\xBF", "\x80", "\xBF", "\xC3", "\xE5\x93", "\xF0\x9F\x98",
+                                   "\xF8\x88\x80\x80\x80", "\xFF", "\x00"};
+    std::string out;
+    for (size_t i = 0; i < pieces; i++) {
+        const unsigned pick = rng() % 1000;
+        if (pick < asciiPercent * 10) {
+            out += (char)(1 + rng() % 127);
+        } else if (pick < 997) {
+            out += valid[rng() % 7];
+        } else {
+            out += invalid[rng() % 14];
+        }
+    }
+    return out;
+}
+
+TEST(UTF8, valid_matches_legacy) {
+    std::mt19937 rng(22);
+    for (size_t iter = 0; iter < 20000; iter++) {
+        const std::string text = random_text(rng, rng() % 120, (unsigned)(rng() % 101));
+        const char *s = text.c_str();
+        const size_t n = rng() % 4 == 0 ? rng() % (text.size() + 1) : SIZE_MAX;
+
+        const char *expected = legacy_utf8nvalid(s, n);
+        ASSERT_EQ((const char *)utf8nvalid(s, n), expected) << iter;
+        if (n == SIZE_MAX) {
+            ASSERT_EQ((const char *)utf8valid(s), expected) << iter;
+        }
+        ASSERT_EQ(utf8nlen(s, n), legacy_utf8nlen(s, n)) << iter;
+        ASSERT_EQ(utf8len(s), legacy_utf8nlen(s, SIZE_MAX)) << iter;
+        ASSERT_EQ(utf8size(s), strlen(s) + 1);
+        ASSERT_EQ(utf8nsize_lazy(s, n), strnlen(s, n));
+    }
+}
+
+TEST(UTF8, nlen_stops_at_terminator) {
+    // A truncated last code point counts once and nothing past the terminator is read
+    const char *truncated[] = {"\xC3", "\xE5\x93", "\xF0\x9F\x98"};
+    for (const char *tail : truncated) {
+        const std::string text = std::string(20, 'a') + tail;
+        const std::vector<char> exact(text.begin(), text.end() + 1);
+        ASSERT_EQ(utf8len(exact.data()), 21u);
+        ASSERT_EQ(utf8nlen(exact.data(), SIZE_MAX), 21u);
+        ASSERT_EQ(utf8nlen(exact.data(), text.size() + 1), 21u);
+        // Cut by n instead
+        ASSERT_EQ(utf8nlen(exact.data(), text.size()), 20u);
+    }
+
+    // An embedded terminator right after a truncated code point ends the string
+    const char embedded[] = "abc\xE5\x93\0xyz";
+    EXPECT_EQ(utf8len(embedded), 4u);
+    EXPECT_EQ(utf8nlen(embedded, sizeof(embedded)), 4u);
+
+    // A code point running past n is not counted, even when it also runs past the terminator
+    EXPECT_EQ(utf8nlen("\xF0\x9F", 3), 0u);
+    EXPECT_EQ(utf8nlen("a\xE5\x93", 3), 1u);
+    EXPECT_EQ(utf8nlen("a\xE5\x93", 4), 2u);
+}
+
+TEST(UTF8, errors_across_blocks) {
+    // Put each malformed sequence at every offset around the 16 byte block boundaries
+    const std::string bad[] = {"\xE0\x80\xAF", "\xF0\x8F\xBF\xBF", "\xC3", "\xE5\x93", "\x80", "\xF8\x88",
+                               "\xC3\xB1\xB1", "\xE5\x93\x88\x88"};
+    for (const auto &b : bad) {
+        for (size_t offset = 0; offset < 40; offset++) {
+            std::string text = std::string(offset, 'a') + b + std::string(40, 'z');
+            ASSERT_EQ((const char *)utf8valid(text.c_str()), legacy_utf8nvalid(text.c_str(), SIZE_MAX)) << offset;
+            text = std::string(offset, 'a') + "\xE5\x93\x88" + b + "\xC3\xB1" + std::string(40, 'z');
+            ASSERT_EQ((const char *)utf8valid(text.c_str()), legacy_utf8nvalid(text.c_str(), SIZE_MAX)) << offset;
+        }
+    }
+}
+
+TEST(UTF8, DISABLED_benchmark) {
+    std::mt19937 rng(2222);
+    std::string ascii, multibyte;
+    while (ascii.size() < 4096) {
+        ascii += "Delegate 100 DOT to validator 15oF4uVJwmo4TdGW7VfQxNLavjCXviqxT9S1MgbjMNHr6Sp5. ";
+    }
+    // Cyrillic and CJK with some ASCII punctuation, as in translated memos
+    const char *pieces[] = {"\xD0\x9F\xD1\x80\xD0\xB8", "\xE4\xBA\xA4\xE6\x98\x93", " ", "1", "\xF0\x9F\x9A\x80", "."};
+    while (multibyte.size() < 4096) {
+        multibyte += pieces[rng() % 6];
+    }
+    ASSERT_EQ(utf8valid(multibyte.c_str()), nullptr);
+
+    const size_t iterations = 2000;
+    volatile size_t sink = 0;
+
+    std::cout << "corpus\t\tbytes\tcall\t\tlegacy[ns]\tfast[ns]" << std::endl;
+    for (const auto &entry : {std::make_pair("ascii", &ascii), std::make_pair("multibyte", &multibyte)}) {
+        const char *s = entry.second->c_str();
+        const double validLegacy =
+            bench_ns([&]() { sink = sink + (size_t)legacy_utf8nvalid(s, SIZE_MAX); }, iterations);
+        const double validFast = bench_ns([&]() { sink = sink + (size_t)utf8valid(s); }, iterations);
+        const double lenLegacy = bench_ns([&]() { sink = sink + legacy_utf8nlen(s, SIZE_MAX); }, iterations);
+        const double lenFast = bench_ns([&]() { sink = sink + utf8len(s); }, iterations);
+        std::cout << entry.first << "\t" << (strlen(entry.first) < 8 ? "\t" : "") << entry.second->size()
+                  << "\tutf8valid\t" << validLegacy << "\t\t" << validFast << std::endl;
+        std::cout << "\t\t\tutf8len\t\t" << lenLegacy << "\t\t" << lenFast << std::endl;
+    }
+}
+
+}  // namespace
@@ -0,0 +1,260 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <gmock/gmock.h>
+
+#include <cinttypes>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "test_utils.h"
+#include "timeutils.h"
+#include "zxfmt.h"
+#include "zxformat.h"
+
+namespace {
+
+TEST(ZXFMT, appends) {
+    char buf[64];
+    zx_fmt_t f;
+    zx_fmt_init(&f, buf, sizeof(buf));
+    EXPECT_STREQ(buf, "");
+
+    zx_fmt_str(&f, "Fee");
+    zx_fmt_char(&f, ' ');
+    zx_fmt_u64(&f, 7, 3);
+    zx_fmt_char(&f, ' ');
+    zx_fmt_i64(&f, INT64_MIN);
+    zx_fmt_char(&f, ' ');
+    zx_fmt_hex(&f, 0xBEEF, 8, bool_false);
+    zx_fmt_char(&f, ' ');
+    zx_fmt_hex(&f, 0, 0, bool_true);
+    zx_fmt_repeat(&f, '.', 3);
+    zx_fmt_strn(&f, "abcdef", 2);
+    zx_fmt_str(&f, nullptr);
+
+    EXPECT_STREQ(buf, "Fee 007 -9223372036854775808 0000beef 0...ab");
+    EXPECT_EQ(f.len, strlen(buf));
+    EXPECT_EQ(zx_fmt_status(&f), zxerr_ok);
+}
+
+TEST(ZXFMT, fixed) {
+    const struct {
+        uint64_t value;
+        uint8_t decimals;
+        const char *expected;
+    } cases[] = {
+        {0, 0, "0"},
+        {0, 3, "0.000"},
+        {5, 1, "0.5"},
+        {50, 3, "0.050"},
+        {12345, 3, "12.345"},
+        {12345, 5, "0.12345"},
+        {12345, 6, "0.012345"},
+        {UINT64_MAX, 19, "1.8446744073709551615"},
+    };
+    for (const auto &c : cases) {
+        char buf[40];
+        zx_fmt_t f;
+        zx_fmt_init(&f, buf, sizeof(buf));
+        zx_fmt_fixed(&f, c.value, c.decimals);
+        EXPECT_STREQ(buf, c.expected);
+    }
+}
+
+TEST(ZXFMT, truncates_like_snprintf) {
+    std::mt19937 rng(17);
+
+    for (size_t size = 1; size < 24; size++) {
+        const uint64_t value = rng();
+        char full[64];
+        snprintf(full, sizeof(full), "Page %" PRIu64 "/%04x", value, 0x2au);
+        const std::string expected = std::string(full).substr(0, size - 1);
+
+        char buf[24];
+        zx_fmt_t f;
+        zx_fmt_init(&f, buf, size);
+        zx_fmt_str(&f, "Page ");
+        zx_fmt_u64(&f, value, 0);
+        zx_fmt_char(&f, '/');
+        zx_fmt_hex(&f, 0x2a, 4, bool_false);
+
+        EXPECT_EQ(std::string(buf), expected) << size;
+        EXPECT_EQ(f.len, expected.size());
+        EXPECT_EQ(zx_fmt_status(&f), strlen(full) >= size ? zxerr_buffer_too_small : zxerr_ok) << size;
+    }
+
+    // Nothing can be written into an empty buffer
+    char untouched = 'x';
+    zx_fmt_t f;
+    zx_fmt_init(&f, &untouched, 0);
+    zx_fmt_str(&f, "a");
+    EXPECT_EQ(untouched, 'x');
+    EXPECT_EQ(zx_fmt_status(&f), zxerr_buffer_too_small);
+
+    char small[4];
+    EXPECT_EQ(zx_fmt_copy(small, sizeof(small), "ERROR"), 3);
+    EXPECT_STREQ(small, "ERR");
+}
+
+TEST(ZXFMT, DISABLED_benchmark_vs_snprintf) {
+    const size_t iterations = 200000;
+    volatile size_t sink = 0;
+    char out[64];
+
+    auto bench = [&](const std::function<void(uint32_t)> &fn) {
+        uint32_t i = 0;
+        return bench_ns(
+            [&]() {
+                fn(i++);
+                sink = sink + (size_t)out[3];
+            },
+            iterations);
+    };
+
+    const double suffixSnprintf = bench([&](uint32_t i) {
+        snprintf(out, sizeof(out), " [%d/%d]", (int)(i % 9 + 1), (int)(i % 7 + 10));
+    });
+    const double suffixFmt = bench([&](uint32_t i) {
+        zx_fmt_t f;
+        zx_fmt_init(&f, out, sizeof(out));
+        zx_fmt_str(&f, " [");
+        zx_fmt_u64(&f, i % 9 + 1, 0);
+        zx_fmt_char(&f, '/');
+        zx_fmt_u64(&f, i % 7 + 10, 0);
+        zx_fmt_char(&f, ']');
+    });
+
+    const uint64_t t0 = 1700000000;
+    const double timeSnprintf = bench([&](uint32_t i) {
+        timedata_t date;
+        extractTime(t0 + i * 97u, &date);
+        snprintf(out, sizeof(out), "%02d%s%04d %02d:%02d:%02dUTC", date.tm_day, date.monthName, date.tm_year,
+                 date.tm_hour, date.tm_min, date.tm_sec);
+    });
+    const double timeFmt = bench([&](uint32_t i) { printTime(out, sizeof(out), t0 + i * 97u); });
+
+    std::cout << "call\t\tsnprintf[ns]\tzx_fmt[ns]" << std::endl;
+    std::cout << "page suffix\t" << suffixSnprintf << "\t\t" << suffixFmt << std::endl;
+    std::cout << "printTime\t" << timeSnprintf << "\t\t" << timeFmt << std::endl;
+}
+
+TEST(ZXSTRBUF, operations) {
+    char buf[16];
+    zx_strbuf_t sb;
+    ASSERT_EQ(zx_strbuf_init(&sb, buf, sizeof(buf), 4), zxerr_ok);
+    EXPECT_STREQ(zx_strbuf_cstr(&sb), "");
+
+    EXPECT_EQ(zx_strbuf_append_str(&sb, "1234"), zxerr_ok);
+    EXPECT_EQ(zx_strbuf_prepend(&sb, "ab", 2), zxerr_ok);
+    EXPECT_EQ(sb.start, 2);
+    EXPECT_STREQ(zx_strbuf_cstr(&sb), "ab1234");
+
+    EXPECT_EQ(zx_strbuf_insert_char(&sb, 1, '-'), zxerr_ok);
+    EXPECT_EQ(zx_strbuf_insert_char(&sb, 6, '.'), zxerr_ok);
+    EXPECT_STREQ(zx_strbuf_cstr(&sb), "a-b123.4");
+    EXPECT_EQ(zx_strbuf_insert_char(&sb, 9, '.'), zxerr_out_of_bounds);
+
+    EXPECT_EQ(zx_strbuf_remove_prefix(&sb, 2), zxerr_ok);
+    EXPECT_EQ(zx_strbuf_truncate(&sb, 3), zxerr_ok);
+    EXPECT_STREQ(zx_strbuf_cstr(&sb), "b12");
+    EXPECT_EQ(zx_strbuf_pad_left(&sb, '0', 6), zxerr_ok);
+    EXPECT_STREQ(zx_strbuf_cstr(&sb), "000b12");
+
+    EXPECT_EQ(zx_strbuf_finish(&sb), 6);
+    EXPECT_STREQ(buf, "000b12");
+
+    char existing[8] = "xyz";
+    ASSERT_EQ(zx_strbuf_wrap(&sb, existing, sizeof(existing)), zxerr_ok);
+    EXPECT_EQ(sb.len, 3);
+    char unterminated[3] = {'a', 'b', 'c'};
+    EXPECT_EQ(zx_strbuf_wrap(&sb, unterminated, sizeof(unterminated)), zxerr_buffer_too_small);
+}
+
+TEST(ZXSTRBUF, all_or_nothing) {
+    char buf[8];
+    zx_strbuf_t sb;
+    ASSERT_EQ(zx_strbuf_init(&sb, buf, sizeof(buf), 0), zxerr_ok);
+    EXPECT_EQ(zx_strbuf_append_str(&sb, "12345"), zxerr_ok);
+
+    EXPECT_EQ(zx_strbuf_append_str(&sb, "678"), zxerr_buffer_too_small);
+    EXPECT_EQ(zx_strbuf_prepend(&sb, "abc", 3), zxerr_buffer_too_small);
+    EXPECT_EQ(zx_strbuf_pad_left(&sb, '0', 8), zxerr_buffer_too_small);
+    EXPECT_STREQ(zx_strbuf_cstr(&sb), "12345");
+
+    EXPECT_EQ(zx_strbuf_prepend(&sb, "ab", 2), zxerr_ok);
+    EXPECT_EQ(zx_strbuf_insert_char(&sb, 3, '.'), zxerr_buffer_too_small);
+    EXPECT_STREQ(zx_strbuf_cstr(&sb), "ab12345");
+
+    // Headroom freed by remove_prefix is reused by the next insertion
+    EXPECT_EQ(zx_strbuf_remove_prefix(&sb, 2), zxerr_ok);
+    EXPECT_EQ(zx_strbuf_insert_char(&sb, 5, '.'), zxerr_ok);
+    EXPECT_EQ(zx_strbuf_insert_char(&sb, 1, '.'), zxerr_ok);
+    EXPECT_EQ(zx_strbuf_finish(&sb), 7);
+    EXPECT_STREQ(buf, "1.2345.");
+}
+
+// Straightforward model of "<symbol><integer>.<fraction>" with trailing zeros trimmed to one decimal
+std::string reference_amount(const std::string &symbol, std::string digits, uint8_t decimals) {
+    digits.erase(0, std::min(digits.find_first_not_of('0'), digits.size() - 1));
+    if (decimals > 0) {
+        if (digits.size() < (size_t)decimals + 1) {
+            digits.insert(0, decimals + 1 - digits.size(), '0');
+        }
+        digits.insert(digits.size() - decimals, 1, '.');
+        const size_t keep = digits.find('.') + 2;
+        while (digits.size() > keep && digits.back() == '0') {
+            digits.pop_back();
+        }
+    }
+    return symbol + digits;
+}
+
+uint16_t format_amount_sb(char *buf, size_t bufLen, const char *symbol, uint8_t decimals) {
+    zx_strbuf_t sb;
+    if (zx_strbuf_wrap(&sb, buf, bufLen) != zxerr_ok || intstr_to_fpstr_sb(&sb, decimals) != zxerr_ok) {
+        return 0;
+    }
+    number_trimming_sb(&sb, 1);
+    if (zx_strbuf_prepend(&sb, symbol, strlen(symbol)) != zxerr_ok) {
+        return 0;
+    }
+    return zx_strbuf_finish(&sb);
+}
+
+TEST(ZXSTRBUF, amount_matches_reference) {
+    std::mt19937_64 rng(18);
+    const char *symbols[] = {"", "ETH ", "USDC ", "A.B "};
+    for (size_t iter = 0; iter < 20000; iter++) {
+        std::string digits(1 + rng() % 40, '0');
+        const size_t zeros = rng() % 4 == 0 ? rng() % digits.size() : 0;
+        for (size_t i = zeros; i < digits.size(); i++) {
+            digits[i] = (char)('0' + rng() % 10);
+        }
+        const uint8_t decimals = (uint8_t)(rng() % 30);
+        const char *symbol = symbols[iter % 4];
+
+        char buf[100] = {0};
+        memcpy(buf, digits.c_str(), digits.size());
+        const std::string expected = reference_amount(symbol, digits, decimals);
+        ASSERT_EQ(format_amount_sb(buf, sizeof(buf), symbol, decimals), expected.size()) << digits;
+        ASSERT_EQ(std::string(buf), expected) << digits << " " << (int)decimals;
+    }
+}
+
+}  // namespace
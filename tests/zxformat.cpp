@@ -17,6 +17,12 @@
 #include <zxformat.h>
 #include <zxmacros.h>
 
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "test_utils.h"
+
 namespace {
 TEST(FORMAT, nothingAdded) {
     char buffer[10];
@@ -149,4 +155,331 @@ TEST(FORMAT, hexstr2array_odd_value) {
 
     EXPECT_EQ(0, hexstr_to_array(data, sizeof(data), s, strlen(s)));
 }
+
+// Previous scalar encoder, one nibble lookup per character
+void legacy_array_to_hexchars(char *dst, const uint8_t *src, size_t count, bool uppercase) {
+    const char *hexchars = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+    for (size_t i = 0; i < count; i++, src++) {
+        *dst++ = hexchars[*src >> 4u];
+        *dst++ = hexchars[*src & 0x0Fu];
+    }
+}
+
+TEST(FORMAT, array_to_hexchars_matches_legacy) {
+    std::mt19937 rng(5);
+    std::vector<uint8_t> data(300);
+    for (auto &b : data) b = rng() & 0xFF;
+
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t len = 0; len + offset <= data.size(); len++) {
+            for (bool upper : {false, true}) {
+                std::vector<char> expected(2 * len + 1, 'x');
+                std::vector<char> actual(2 * len + 1, 'x');
+                legacy_array_to_hexchars(expected.data(), data.data() + offset, len, upper);
+                array_to_hexchars(actual.data(), data.data() + offset, len, upper);
+                ASSERT_EQ(expected, actual) << "offset=" << offset << " len=" << len;
+            }
+        }
+    }
+
+    // every byte value, both cases
+    uint8_t all[256];
+    for (size_t i = 0; i < sizeof(all); i++) all[i] = (uint8_t)i;
+    char out[2 * sizeof(all) + 1];
+    EXPECT_EQ(array_to_hexstr_uppercase(out, sizeof(out), all, sizeof(all)), 2 * sizeof(all));
+    EXPECT_EQ(std::string(out, 6), "000102");
+    EXPECT_EQ(std::string(out + 2 * 0xAB, 4), "ABAC");
+    EXPECT_EQ(array_to_hexstr(out, sizeof(out), all, sizeof(all)), 2 * sizeof(all));
+    EXPECT_EQ(std::string(out + 2 * 0xFE, 4), "feff");
+}
+
+TEST(FORMAT, DISABLED_benchmark_array_to_hexchars) {
+    std::mt19937 rng(11);
+    std::cout << "size\tlegacy[MB/s]\tcurrent[MB/s]" << std::endl;
+    for (size_t size : {32, 1024, 65536}) {
+        std::vector<uint8_t> data = random_bytes(rng, size);
+        std::vector<char> out(2 * size);
+        const size_t iterations = (4u << 20) / size;
+
+        auto megabytes_per_second = [&](void (*fn)(char *, const uint8_t *, size_t, bool)) {
+            size_t i = 0;
+            const double ns = bench_ns(
+                [&]() {
+                    fn(out.data(), data.data(), size, false);
+                    data[i % size] ^= (uint8_t)out[i % (2 * size)];
+                    i++;
+                },
+                iterations);
+            return (double)size * 1000.0 / ns;
+        };
+        const double legacy = megabytes_per_second(legacy_array_to_hexchars);
+        const double current = megabytes_per_second(array_to_hexchars);
+        std::cout << size << "\t" << legacy << "\t\t" << current << std::endl;
+    }
+}
+
+template <typename T, typename F>
+void check_to_str_len(F fn, T value) {
+    const std::string expected = std::to_string(value);
+    char out[32];
+    ASSERT_EQ(fn(out, sizeof(out), value), expected.size()) << expected;
+    ASSERT_EQ(std::string(out), expected);
+
+    // Exact fit, then one byte short
+    std::vector<char> exact(expected.size() + 1, 'x');
+    ASSERT_EQ(fn(exact.data(), (uint16_t)exact.size(), value), expected.size()) << expected;
+    ASSERT_EQ(std::string(exact.data()), expected);
+    std::vector<char> small(expected.size(), 'x');
+    ASSERT_EQ(fn(small.data(), (uint16_t)small.size(), value), 0) << expected;
+    ASSERT_EQ(std::vector<char>(expected.size(), 0), small);
+}
+
+TEST(FORMAT, to_str_len_matches_to_string) {
+    std::mt19937_64 rng(15);
+
+    std::vector<uint64_t> values = {0, UINT64_MAX, UINT32_MAX, (uint64_t)UINT32_MAX + 1};
+    for (uint64_t p = 1; p <= 1000000000000000000ull; p *= 10) {
+        values.push_back(p - 1);
+        values.push_back(p);
+        values.push_back(p + 1);
+        values.push_back(p * 10 - 1);
+    }
+    for (int i = 0; i < 20000; i++) {
+        // Spread over all bit lengths
+        values.push_back(rng() >> (rng() % 64));
+    }
+
+    for (const uint64_t v : values) {
+        check_to_str_len<uint64_t>(uint64_to_str_len, v);
+        check_to_str_len<int64_t>(int64_to_str_len, (int64_t)v);
+        check_to_str_len<uint32_t>(uint32_to_str_len, (uint32_t)v);
+        check_to_str_len<int32_t>(int32_to_str_len, (int32_t)v);
+    }
+    check_to_str_len<int64_t>(int64_to_str_len, INT64_MIN);
+    check_to_str_len<int32_t>(int32_to_str_len, INT32_MIN);
+
+    char out[4] = {'x', 'x', 'x', 'x'};
+    EXPECT_EQ(int64_to_str_len(out, 1, -1), 0);
+    EXPECT_EQ(out[0], 0);
+    EXPECT_EQ(uint64_to_str_len(out, 0, 0), 0);
+    EXPECT_EQ(out[0], 0);
+    EXPECT_EQ(uint64_to_str_len(nullptr, 10, 0), 0);
+}
+
+void legacy_pageStringExt(char *outValue, uint16_t outValueLen, const char *inValue, uint16_t inValueLen,
+                          uint8_t pageIdx, uint8_t *pageCount) {
+    MEMZERO(outValue, outValueLen);
+    *pageCount = 0;
+    outValueLen--;
+    if (outValueLen == 0 || inValueLen == 0) {
+        return;
+    }
+    *pageCount = (uint8_t)(inValueLen / outValueLen);
+    const uint16_t lastChunkLen = (inValueLen % outValueLen);
+    if (lastChunkLen > 0) {
+        (*pageCount)++;
+    }
+    if (pageIdx < *pageCount) {
+        const uint16_t len = (lastChunkLen > 0 && pageIdx == *pageCount - 1) ? lastChunkLen : outValueLen;
+        MEMCPY(outValue, inValue + (pageIdx * outValueLen), len);
+    }
+}
+
+std::string random_utf8(std::mt19937 &rng, size_t codepoints) {
+    // 1, 2, 3 and 4 byte encodings
+    const char *samples[] = {"a", "Z", " ", "\xC3\xA9", "\xD0\x96", "\xE2\x82\xAC", "\xE6\x97\xA5", "\xF0\x9F\x98\x80"};
+    std::string out;
+    for (size_t i = 0; i < codepoints; i++) {
+        out += samples[rng() % 8];
+    }
+    return out;
+}
+
+TEST(PAGING, ascii_matches_legacy_layout) {
+    std::mt19937 rng(19);
+    for (uint16_t len = 0; len < 300; len += 7) {
+        std::string value(len, 'x');
+        for (auto &c : value) {
+            c = (char)(0x20 + rng() % 0x5f);
+        }
+        for (uint16_t outLen = 2; outLen < 40; outLen += 5) {
+            if (len / (outLen - 1) >= UINT8_MAX) {
+                // Legacy page count wraps around
+                continue;
+            }
+            char expected[64], actual[64];
+            uint8_t expectedCount = 0, actualCount = 0;
+            legacy_pageStringExt(expected, outLen, value.c_str(), len, 0, &expectedCount);
+            pageStringExt(actual, outLen, value.c_str(), len, 0, &actualCount);
+            ASSERT_EQ(expectedCount, actualCount) << len << " " << outLen;
+
+            page_table_t pt;
+            page_table_init(&pt, value.c_str(), len, outLen);
+            EXPECT_TRUE(pt.uniform);
+            for (uint8_t idx = 0; idx <= expectedCount; idx++) {
+                legacy_pageStringExt(expected, outLen, value.c_str(), len, idx, &expectedCount);
+                page_table_get(&pt, actual, outLen, idx);
+                ASSERT_STREQ(expected, actual) << len << " " << outLen << " " << (int)idx;
+            }
+        }
+    }
+}
+
+TEST(PAGING, utf8_pages_keep_codepoints) {
+    std::mt19937 rng(191);
+    for (size_t iter = 0; iter < 500; iter++) {
+        const std::string value = random_utf8(rng, 1 + rng() % 200);
+        const uint16_t outLen = (uint16_t)(5 + rng() % 30);
+
+        page_table_t pt;
+        page_table_init(&pt, value.c_str(), (uint16_t)value.size(), outLen);
+
+        std::string joined;
+        for (uint8_t idx = 0; idx < pt.pageCount; idx++) {
+            char page[64];
+            page_table_get(&pt, page, outLen, idx);
+            const size_t pageLen = strlen(page);
+            ASSERT_GT(pageLen, 0u);
+            ASSERT_LT(pageLen, outLen);
+            // Pages never start with a continuation byte
+            ASSERT_NE((uint8_t)page[0] & 0xC0u, 0x80u);
+            joined += page;
+        }
+        ASSERT_EQ(joined, value);
+
+        // Same result without keeping the table
+        for (uint8_t idx = 0; idx <= pt.pageCount; idx++) {
+            char a[64], b[64];
+            uint8_t count = 0;
+            pageStringExt(a, outLen, value.c_str(), (uint16_t)value.size(), idx, &count);
+            page_table_get(&pt, b, outLen, idx);
+            ASSERT_EQ(count, pt.pageCount);
+            ASSERT_STREQ(a, b);
+        }
+    }
+}
+
+TEST(PAGING, narrow_pages_and_limits) {
+    // A page narrower than a codepoint has to split it
+    const std::string smile = "\xF0\x9F\x98\x80\xF0\x9F\x98\x80";
+    page_table_t pt;
+    page_table_init(&pt, smile.c_str(), (uint16_t)smile.size(), 3);
+    EXPECT_EQ(pt.pageCount, 4);
+
+    char out[8];
+    page_table_get(&pt, out, sizeof(out), 4);
+    EXPECT_STREQ(out, "");
+
+    page_table_init(&pt, smile.c_str(), 0, sizeof(out));
+    EXPECT_EQ(pt.pageCount, 0);
+    page_table_init(&pt, smile.c_str(), (uint16_t)smile.size(), 1);
+    EXPECT_EQ(pt.pageCount, 0);
+
+    // Stray continuation bytes after ASCII are not a codepoint, so the cut stays put
+    const std::string stray = "abcd\x80\x80xyz";
+    page_table_init(&pt, stray.c_str(), (uint16_t)stray.size(), 6);
+    EXPECT_EQ(pt.pageCount, 2);
+    page_table_get(&pt, out, 6, 0);
+    EXPECT_STREQ(out, "abcd\x80");
+    page_table_get(&pt, out, 6, 1);
+    EXPECT_STREQ(out, "\x80xyz");
+    uint8_t strayCount = 0;
+    pageStringExt(out, 6, stray.c_str(), (uint16_t)stray.size(), 1, &strayCount);
+    EXPECT_EQ(strayCount, 2);
+    EXPECT_STREQ(out, "\x80xyz");
+
+    // Both stop counting at 255 pages
+    std::string longValue;
+    for (int i = 0; i < 300; i++) {
+        longValue += "a\xC3\xB1";
+    }
+    uint8_t count = 0;
+    page_table_init(&pt, longValue.c_str(), (uint16_t)longValue.size(), 3);
+    EXPECT_EQ(pt.pageCount, UINT8_MAX);
+    pageStringExt(out, 3, longValue.c_str(), (uint16_t)longValue.size(), 254, &count);
+    EXPECT_EQ(count, UINT8_MAX);
+    char expected[8];
+    page_table_get(&pt, expected, 3, 254);
+    EXPECT_STREQ(out, expected);
+}
+
+zxerr_t legacy_formatBufferData(const uint8_t *ptr, uint64_t len, char *outValue, uint16_t outValueLen,
+                                uint8_t pageIdx, uint8_t *pageCount) {
+    char bufferUI[500 + 1];
+    MEMZERO(bufferUI, sizeof(bufferUI));
+    MEMZERO(outValue, outValueLen);
+    if (len >= sizeof(bufferUI)) {
+        return zxerr_buffer_too_small;
+    }
+    if (len > 0) {
+        memcpy(bufferUI, ptr, len);
+    }
+
+    uint8_t allAscii = 1;
+    for (size_t i = 0; i < len && allAscii; i++) {
+        if ((uint8_t)bufferUI[i] < 32 || (uint8_t)bufferUI[i] > 127) {
+            allAscii = 0;
+        }
+    }
+    if (!allAscii) {
+        bufferUI[0] = '0';
+        bufferUI[1] = 'x';
+        if (array_to_hexstr(bufferUI + 2, sizeof(bufferUI) - 2, ptr, len) == 0) {
+            return zxerr_buffer_too_small;
+        }
+    }
+    legacy_pageStringExt(outValue, outValueLen, bufferUI, strlen(bufferUI), pageIdx, pageCount);
+    return zxerr_ok;
+}
+
+TEST(PAGING, formatBufferData_matches_legacy) {
+    std::mt19937 rng(20);
+    for (size_t iter = 0; iter < 3000; iter++) {
+        std::vector<uint8_t> data(rng() % 249);
+        const bool ascii = rng() % 2 == 0;
+        for (auto &b : data) {
+            b = (uint8_t)(ascii ? 32 + rng() % 96 : rng());
+        }
+        const uint16_t outLen = (uint16_t)(2 + rng() % 60);
+
+        char expected[64], actual[64];
+        uint8_t expectedCount = 0, actualCount = 0;
+        ASSERT_EQ(legacy_formatBufferData(data.data(), data.size(), expected, outLen, 0, &expectedCount), zxerr_ok);
+        if ((2 + 2 * data.size() + outLen - 2) / (outLen - 1) > UINT8_MAX) {
+            // Legacy page count wraps around
+            continue;
+        }
+        for (uint8_t idx = 0; idx <= expectedCount; idx++) {
+            legacy_formatBufferData(data.data(), data.size(), expected, outLen, idx, &expectedCount);
+            ASSERT_EQ(formatBufferData(data.data(), data.size(), actual, outLen, idx, &actualCount), zxerr_ok);
+            ASSERT_EQ(expectedCount, actualCount);
+            ASSERT_STREQ(expected, actual) << data.size() << " " << outLen << " " << (int)idx;
+        }
+    }
+}
+
+TEST(PAGING, formatBufferData_large_blob) {
+    std::vector<uint8_t> calldata(4000);
+    for (size_t i = 0; i < calldata.size(); i++) {
+        calldata[i] = (uint8_t)(i * 7);
+    }
+    std::vector<char> hex(2 * calldata.size() + 1);
+    array_to_hexstr(hex.data(), hex.size(), calldata.data(), calldata.size());
+
+    char page[64];
+    uint8_t pageCount = 0;
+    std::string joined;
+    ASSERT_EQ(formatBufferData(calldata.data(), calldata.size(), page, sizeof(page), 0, &pageCount), zxerr_ok);
+    EXPECT_EQ(pageCount, (2 + 8000 + 62) / 63);
+    for (uint8_t idx = 0; idx < pageCount; idx++) {
+        ASSERT_EQ(formatBufferData(calldata.data(), calldata.size(), page, sizeof(page), idx, &pageCount), zxerr_ok);
+        joined += page;
+    }
+    EXPECT_EQ(joined, "0x" + std::string(hex.data()));
+
+    // More than 255 pages cannot be shown
+    EXPECT_EQ(formatBufferData(calldata.data(), calldata.size(), page, 20, 0, &pageCount), zxerr_buffer_too_small);
+    EXPECT_EQ(pageCount, 0);
+}
+
 }  // namespace
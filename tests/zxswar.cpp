@@ -0,0 +1,82 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <gmock/gmock.h>
+
+#include <random>
+#include <vector>
+
+#include "zxformat.h"
+#include "zxswar.h"
+
+namespace {
+
+size_t reference_find_outside(const uint8_t *data, size_t len, uint8_t lo, uint8_t hi) {
+    for (size_t i = 0; i < len; i++) {
+        if (data[i] < lo || data[i] > hi) {
+            return i;
+        }
+    }
+    return len;
+}
+
+TEST(ZXSWAR, scans_match_reference) {
+    std::mt19937 rng(23);
+    std::vector<uint8_t> buf(80);
+    for (size_t iter = 0; iter < 20000; iter++) {
+        // Mostly printable bytes with an occasional stray one anywhere in the word
+        for (auto &b : buf) {
+            b = (uint8_t)(rng() % 50 == 0 ? rng() : 0x20 + rng() % 0x5F);
+        }
+        const size_t offset = rng() % 8;
+        const size_t len = rng() % (buf.size() - offset);
+        const uint8_t *data = buf.data() + offset;
+
+        ASSERT_EQ(zx_swar_find_non_printable(data, len), reference_find_outside(data, len, 0x20, 0x7E));
+        ASSERT_EQ(zx_swar_find_outside(data, len, 32, 127), reference_find_outside(data, len, 32, 127));
+        ASSERT_EQ(zx_swar_find_outside(data, len, 0, 0x7F), reference_find_outside(data, len, 0, 0x7F));
+        ASSERT_EQ(zx_swar_all_printable(data, len) == bool_true, reference_find_outside(data, len, 0x20, 0x7E) == len);
+
+        size_t zero = len;
+        for (size_t i = 0; i < len && zero == len; i++) {
+            zero = data[i] == 0 ? i : len;
+        }
+        ASSERT_EQ(zx_swar_find_zero(data, len), zero);
+    }
+}
+
+TEST(ZXSWAR, case_fold) {
+    std::vector<uint8_t> all(256);
+    for (size_t i = 0; i < all.size(); i++) {
+        all[i] = (uint8_t)i;
+    }
+
+    std::vector<uint8_t> upper(all), lower(all);
+    zx_swar_to_upper(upper.data(), upper.size());
+    zx_swar_to_lower(lower.data(), lower.size());
+    for (size_t i = 0; i < all.size(); i++) {
+        EXPECT_EQ(upper[i], (i >= 'a' && i <= 'z') ? i - 0x20 : i);
+        EXPECT_EQ(lower[i], (i >= 'A' && i <= 'Z') ? i + 0x20 : i);
+    }
+
+    uint8_t text[] = "0xAbCdEf0123 Mixed-Case_z";
+    EXPECT_EQ(array_to_uppercase(text, sizeof(text) - 1), zxerr_ok);
+    EXPECT_STREQ((const char *)text, "0XABCDEF0123 MIXED-CASE_Z");
+    EXPECT_EQ(array_to_lowercase(text + 3, 5), zxerr_ok);
+    EXPECT_STREQ((const char *)text, "0XAbcdef0123 MIXED-CASE_Z");
+    EXPECT_EQ(array_to_lowercase(nullptr, 5), zxerr_no_data);
+}
+
+}  // namespace